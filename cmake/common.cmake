@@ -35,9 +35,15 @@ if(CMAKE_COMPILER_IS_GNUCXX)
   "${CMAKE_CXX_FLAGS_RELEASE} -flto"
   )
   
-  set(CMAKE_CXX_FLAGS_RELEASE 
-  "${CMAKE_CXX_FLAGS_RELEASE} -march=native"
-  )
+  # Tuning for the build host : the binary may not run on older cpus.
+  # Without it, the BMI2/ADX, AVX2, AVX-512 IFMA and SHA-NI kernels are still
+  # built and selected at runtime (see ecl/dispatch.h)
+  option(ECL_NATIVE "Compile for the instruction set of the build host" ON)
+  if (ECL_NATIVE)
+    set(CMAKE_CXX_FLAGS_RELEASE 
+    "${CMAKE_CXX_FLAGS_RELEASE} -march=native"
+    )
+  endif()
   
   SET(CMAKE_EXE_LINKER_FLAGS_RELEASE "${CMAKE_EXE_LINKER_FLAGS} -flto")
   SET(CMAKE_AR  "gcc-ar")
@@ -16,19 +16,37 @@ using std::string;
 
 namespace ecl {
 
+/** Tag for constructing an element without initializing its content. */
+enum Uninitialized {
+  UNINITIALIZED  //!< content is left undefined
+};
+
+/** Byte order of the binary representations. */
+enum ByteOrder {
+  BYTES_BE,  //!< most significant byte first
+  BYTES_LE  //!< least significant byte first
+};
+
 /** Template for fixed size precision big integers.
+ * This is a plain limb array : no vtable, trivially copyable, and aligned on
+ * 32 bytes (64 bytes for 512 bits and above) so that arrays of elements are
+ * densely packed.
+ * @note: content is not wiped on destruction, call zero() on secret values.
  */
 template<int nb_limbs>
-class FixedSizedInt {
+class alignas(nb_limbs * DIGIT_BYTES >= 64 ? 64 : 32) FixedSizedInt {
  public:
   /** Basic contructor.
    * Zeroizes content.
    */
-  FixedSizedInt();
-  /** Basic destructor.
-   * Zeroizes content.
+  FixedSizedInt() {
+    std::memset(val, 0, nb_limbs * sizeof(ecl_digit));
+  }
+
+  /** Contructor leaving content undefined.
    */
-  virtual ~FixedSizedInt();
+  explicit FixedSizedInt(Uninitialized) {
+  }
 
   /** Number of limbs of the number representation */
   static const int nb_limbs_ = nb_limbs;
@@ -82,6 +100,30 @@ class FixedSizedInt {
    */
   ErrCode fromString(int *sign, const string str);
 
+  /** Number of bytes of the element content */
+  static const int nb_bytes_ = nb_limbs * DIGIT_BYTES;
+
+  /** Writes the element as a len bytes unsigned integer, without allocation.
+   * The value is zero padded if len > nb_bytes_.
+   * @param[out] out buffer of len bytes
+   * @param[in] len size of the representation
+   * @param[in] order byte order
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if the value does not fit in len bytes, out is
+   * then truncated
+   */
+  ErrCode toBytes(unsigned char *out, size_t len, ByteOrder order) const;
+
+  /** Reads element from a len bytes unsigned integer, without allocation.
+   * @param[in] in buffer of len bytes
+   * @param[in] len size of the representation
+   * @param[in] order byte order
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if the value does not fit in the element, the
+   * element is then truncated
+   */
+  ErrCode fromBytes(const unsigned char *in, size_t len, ByteOrder order);
+
   /** Get bit size
    * @return bit size of element
    */
@@ -182,6 +224,45 @@ class FixedSizedInt {
   static void mul(FixedSizedInt<nb_limbs> *res, const FixedSizedInt<nb_limbs> &a,
                   const FixedSizedInt<nb_limbs> &b);
 
+  /** Full width multiplication, res = a * b on 2 * nb_limbs digits.
+   * Product scanning up to 12 limbs, one Karatsuba level over the half
+   * size product scanning from 16 limbs.
+   * @param[out] res result, shall not overlap a or b
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  static void mul_wide(FixedSizedInt<2 * nb_limbs> *res,
+                       const FixedSizedInt<nb_limbs> &a,
+                       const FixedSizedInt<nb_limbs> &b);
+
+  /** Full width squaring, res = a^2 on 2 * nb_limbs digits.
+   * @param[out] res result, shall not overlap a
+   * @param[in] a operand
+   */
+  static void sqr_wide(FixedSizedInt<2 * nb_limbs> *res,
+                       const FixedSizedInt<nb_limbs> &a);
+
+  /** Computes the Barrett constant of a modulus, mu = floor(b^(2k) / m)
+   * with b = 2^DIGIT_BITS and k = nb_limbs.
+   * @param[out] mu Barrett constant (k + 1 significant digits)
+   * @param[in] m modulus, its most significant digit shall not be zero
+   */
+  static void barrett_setup(FixedSizedInt<2 * nb_limbs> *mu,
+                            const FixedSizedInt<nb_limbs> &m);
+
+  /** Barrett reduction, res = a mod m.
+   * Any 2 * nb_limbs digits value is accepted, e.g. a 512 bits hash output
+   * for 256 bits moduli. Constant time.
+   * @param[out] res result
+   * @param[in] a operand
+   * @param[in] m modulus
+   * @param[in] mu Barrett constant of m, see barrett_setup()
+   */
+  static void barrett_reduce(FixedSizedInt<nb_limbs> *res,
+                             const FixedSizedInt<2 * nb_limbs> &a,
+                             const FixedSizedInt<nb_limbs> &m,
+                             const FixedSizedInt<2 * nb_limbs> &mu);
+
   /** Right shift of b bits.
    * @param[out] res result
    * @param[in] a operand 1
@@ -192,5 +273,43 @@ class FixedSizedInt {
 
 };
 
+/** Non secret value.
+ * Content is neither initialized on construction nor wiped on destruction.
+ * May be used wherever the wrapped type is expected.
+ */
+template<class T>
+class Public : public T {
+ public:
+  /** Basic contructor.
+   * Content is undefined.
+   */
+  Public()
+      : T(UNINITIALIZED) {
+  }
+};
+
+/** Secret value.
+ * Content is zeroized on construction and wiped on destruction.
+ * May be used wherever the wrapped type is expected. T is an element or any
+ * trivially copyable aggregate of elements, e.g. a curve point.
+ */
+template<class T>
+class Secret : public T {
+ public:
+  /** Basic contructor.
+   * Zeroizes content.
+   */
+  Secret() {
+    *static_cast<T *>(this) = T();
+  }
+
+  /** Basic destructor.
+   * Wipes content.
+   */
+  ~Secret() {
+    ZEROMEM(static_cast<T *>(this), sizeof(T));
+  }
+};
+
 } /* namespace ecl */
 #endif /* ECL_INCLUDE_BIGINT_FIXEDSIZEDINT_H_ */
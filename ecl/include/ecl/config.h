@@ -55,6 +55,9 @@ typedef uint64_t ecl_word;
 #ifdef MSVC
 #define ZEROMEM(ptr, size) SecureZeroMemory(ptr, size);
 #else
-#define ZEROMEM(ptr, size) std::memset(ptr, 0, size);
+/* memset called through a volatile pointer, so that wiping a value that is
+ * not read anymore is not removed as a dead store */
+static void *(*const volatile ecl_wipe)(void *, int, size_t) = std::memset;
+#define ZEROMEM(ptr, size) ecl_wipe(ptr, 0, size);
 #endif
 #endif // ECL_CONFIG_H
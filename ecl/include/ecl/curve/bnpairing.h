@@ -29,6 +29,44 @@ using ecl::field::Fp12;
 namespace ecl {
 namespace curve {
 
+/** Squarings of the final exponentiation hard part of BNPairing::pair().
+ * Both compute the same value.
+ */
+enum FinalExpMethod {
+  FINAL_EXP_GS,  //!< hard part with Granger-Scott squarings between the powers
+  FINAL_EXP_COMPRESSED  //!< hard part squarings folded into compressed powers
+};
+
+class BNPairing;
+
+/** Miller loop line coefficients of a fixed point of the twisted curve.
+ * Filled by BNPairing::prepare() and only usable with the BNPairing object
+ * that prepared it. Pairings with the same second argument then skip all the
+ * \f$ F_{p^{2}} \f$ point arithmetic of the Miller loop.
+ */
+class PreparedG2 {
+ public:
+  /** Basic contructor */
+  PreparedG2();
+
+  /** Basic destructor, the coefficients are wiped */
+  ~PreparedG2();
+
+  /** Wipes and frees the coefficients */
+  void clear();
+
+ private:
+  Fp2::Element *lines_;  // 3 coefficients per line, in loop order
+  int nb_lines_;
+  const BNPairing *pairing_;  // object that prepared the lines
+
+  // not copyable
+  PreparedG2(const PreparedG2 &);
+  PreparedG2 &operator=(const PreparedG2 &);
+
+  friend class BNPairing;
+};
+
 /** Performs some pairing computation on BN curves.
  *
  */
@@ -61,6 +99,56 @@ class BNPairing {
   void pair(Fp12::Element *res, const GFpBnCurve::Point &P,
             const Fp2BnCurve::Point &Q);
 
+  /** Precomputes the Miller loop lines of Q.
+   @param[out] prepared line coefficients, previous content is released
+   @param[in] Q point on the twisted curve
+   */
+  void prepare(PreparedG2 *prepared, const Fp2BnCurve::Point &Q);
+
+  /** Compute the optimal ate pairing of P and a prepared point.
+   Same result as pair() called with the point given to prepare().
+   @param res result
+   @param P point on the elliptic curve
+   @param Q lines prepared by this object
+
+   @return ERR_OK in case of success
+   @return ERR_INVALID_VALUE if Q was not prepared by this object, res being
+   then left unchanged
+   */
+  ErrCode pair(Fp12::Element *res, const GFpBnCurve::Point &P,
+               const PreparedG2 &Q);
+
+  /** Compute the product of n optimal ate pairings.
+   The Miller loops of up to 8 pairs share the squarings of their accumulator
+   and a single final exponentiation is done. Allocation free, any n.
+   Pairs with a point at infinity are skipped.
+   @param[out] res \f$ \prod_{i} e(P_{i}, Q_{i}) \f$
+   @param[in] P points on the elliptic curve
+   @param[in] Q points on the twisted curve
+   @param[in] n number of pairs
+   */
+  void multi_pair(Fp12::Element *res, const GFpBnCurve::Point *P,
+                  const Fp2BnCurve::Point *Q, size_t n);
+
+  /** Checks a pairing equation.
+   @param[in] P points on the elliptic curve
+   @param[in] Q points on the twisted curve
+   @param[in] n number of pairs
+
+   @return true if \f$ \prod_{i} e(P_{i}, Q_{i}) = 1 \f$
+   @return false otherwise
+   */
+  bool pairing_check(const GFpBnCurve::Point *P, const Fp2BnCurve::Point *Q,
+                     size_t n);
+
+  /** Selects the final exponentiation of pair() and multi_pair().
+   @param method final exponentiation algorithm, FINAL_EXP_COMPRESSED by
+   default
+   */
+  void setFinalExp(FinalExpMethod method) {
+    final_exp_ = method;
+  }
+
   /** Get the curve defined over G1 (\f$ GF_{p} \f$)
    @return the curve defined over G1
    */
@@ -100,6 +188,13 @@ class BNPairing {
   int s_[256];
   int s_sz_;
 
+  FinalExpMethod final_exp_;
+
+  // compressed powers of exp_t() decompressed together, kept on the stack
+  static const size_t EXP_T_CHUNK = 8;
+  // pairs whose Miller loops share the squarings, kept on the stack
+  static const size_t PAIR_CHUNK = 8;
+
   GFp *gfp;
   Fp2 *fp2;
   Fp6 *fp6;
@@ -109,30 +204,53 @@ class BNPairing {
 
   void get_6tp2(GFp::Element *p, const GFp::Element &t, int sign);
 
-  void exp_t(Fp12::Element *res, const Fp12::Element &f);
+  void exp_t(Fp12::Element *res, const Fp12::Element &f, int k);
   void sqr_cycl(Fp12::Element *res, const Fp12::Element &f);
+  void sqr_compressed(Fp12::Element *res, const Fp12::Element &f);
+  void decompress_batch(Fp12::Element *g, size_t n);
 
   void sqr_fp4(Fp2::Element *c0, Fp2::Element *c1, const Fp2::Element &a,
                const Fp2::Element &b);
 
   void mult_L(Fp12::Element *f, const Fp12::Element lpq);
 
-  void mulFp2Fp2(Fp6::Element *z, const Fp6::Element& x, const Fp2::Element& ya,
+  void mulLines(Fp12::Element *l, const Fp12::Element &la,
+                const Fp12::Element &lb);
+
+  void mult_LL(Fp12::Element *f, const Fp12::Element &l);
+
+  void mulFp2Fp2(Fp6::Double *z, const Fp6::Element& x, const Fp2::Element& ya,
                  const Fp2::Element& yb);
 
-  void doubleAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
-                         const GFpBnCurve::Point &P,
-                         const Fp2BnCurve::Point &Q);
+  void doubleLine(Fp2BnCurve::Point *T, Fp2::Element *l,
+                  const Fp2BnCurve::Point &Q);
+
+  void addLine(Fp2BnCurve::Point *T, Fp2::Element *l,
+               const Fp2BnCurve::Point &Q, const Fp2BnCurve::Point &R);
+
+  void evalLine(Fp12::Element *lqq, const Fp2::Element *l,
+                const GFpBnCurve::Point &P);
 
-  void addAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
-                      const GFpBnCurve::Point &P, const Fp2BnCurve::Point &Q,
-                      const Fp2BnCurve::Point &R);
+  int nb_lines() const;
 
   void millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
                   const Fp2BnCurve::Point &Q);
 
+  void millerLoop(Fp12::Element *f, const GFpBnCurve::Point *P,
+                  const Fp2BnCurve::Point *Q, size_t n);
+
+  void millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
+                  const PreparedG2 &Q);
+
+  void accumulateLine(Fp12::Element *f, Fp12::Element *pending,
+                      bool *has_pending, const Fp2::Element *l,
+                      const GFpBnCurve::Point &P);
+
+  void exp_2t(Fp12::Element *res, const Fp12::Element &f);
   void finalExp(Fp12::Element *res, const Fp12::Element &f);
-  void finalExpNew(Fp12::Element *res, const Fp12::Element &f);
+
+  // white box tests of the cyclotomic squarings
+  friend class BNPairingInternals;
 };
 
 /** BN pairing Factory : to get standard parameters to computes pairings over BN curves.
@@ -6,6 +6,7 @@
 #ifndef ECL_INCLUDE_ECL_CURVE_CURVE_H_
 #define ECL_INCLUDE_ECL_CURVE_CURVE_H_
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 
@@ -13,6 +14,7 @@
 #include "ecl/errcode.h"
 
 #include "ecl/field/GFp.h"
+#include "ecl/field/Fr.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
 #include "ecl/field/Fp12.h"
@@ -20,6 +22,7 @@
 using std::string;
 using ecl::field::GFp;
 using ecl::field::Fp2;
+using ecl::field::Fr;
 
 namespace ecl {
 /**  Elliptic curve module.
@@ -53,6 +56,13 @@ class FpnCurve {
     bool isInfinity;  //!< is it the point at infinity
   } ;
 
+  /** Largest window size of mul_SW() */
+  static const int MAX_WINDOW_SZ = 6;
+
+  /** Number of points whose 1/z² and 1/z³ are computed at once by the
+   * batch normalization, which works on the stack */
+  static const size_t BATCH_CHUNK = 32;
+
   /** Base constructor.
    */
   FpnCurve();
@@ -68,6 +78,13 @@ class FpnCurve {
     return field_;
   }
 
+  /** Gets the scalar field of the curve, integers modulo its order.
+   @return a pointer to the scalar field of the curve.
+   */
+  Fr *getScalarField() {
+    return scalar_field_;
+  }
+
   /** Initialize relying field and curve parameters.
    * The base finite field is an extension of GFp.
    The equation of the curve is in the form \f$ Y^2 = X^3 + aX + b \f$
@@ -129,6 +146,14 @@ class FpnCurve {
    */
   void normalize(Point *res);
 
+  /** Normalize n points.
+   Same as normalize() on each point, with a single field inversion.
+   Allocation free, the z2 of the points hold the intermediate products.
+   @param res Points to normalize
+   @param n number of points
+   */
+  void normalize(Point *res, size_t n);
+
   /** Sets a point to the point at infinity.
    @param res Point to set
 
@@ -207,7 +232,9 @@ class FpnCurve {
    * \param[out] res result point
    * \param[in]  P point to multiply
    * \param[in]  k field member
-   * \param[in]  window_sz window size
+   * \param[in]  window_sz window size, from 1 to MAX_WINDOW_SZ
+   * \return ERR_OK in case of success
+   * \return ERR_INVALID_VALUE if the window size is out of range
    */
   ErrCode mul_SW(Point *res, const Point &P, const GFp::Element &k,
                  int window_sz);
@@ -237,6 +264,8 @@ class FpnCurve {
  protected:
   /**  base field of the curve */
   BaseField *field_;
+  /**  scalar field of the curve */
+  Fr *scalar_field_;
 
   /** Whether the parameter of the curve a == -3 mod p*/
   bool a_is_m3_;
@@ -286,6 +315,18 @@ class GFpCurve : public FpnCurve<GFp> {
    */
   ErrCode compress(GFp::Element *x, int *y, const Point &P);
 
+  /** Exports n points to their compressed form.
+   Points are normalized with a single field inversion, x holds the
+   intermediate products.
+   @param[out] x will contain the compressed forms of the points
+   @param[out] y 0 or 1 (lsb of P[i].y)
+   @param[in]  P points to compress
+   @param[in]  n number of points
+   @return ERR_SUCCESS if success
+   @return an error code otherwise
+   */
+  ErrCode compress(GFp::Element *x, int *y, const Point *P, size_t n);
+
   /** Imports a point from its compressed form.
    @param[out] P decompressed point
    @param[in]  x which contains the compressed form of the point abscissa
@@ -0,0 +1,49 @@
+/**
+ * @file dispatch.h
+ *
+ * Part of the ecl library.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef ECL_DISPATCH_H_
+#define ECL_DISPATCH_H_
+
+#include "ecl/errcode.h"
+
+namespace ecl {
+
+/** Arithmetic backends, from the most portable to the fastest.
+ * A backend also enables the kernels of the previous ones, each kernel being
+ * used only if the running cpu supports it.
+ * The backend is chosen once from cpuid. The ECL_BACKEND environment variable
+ * (generic, bmi2, avx2 or avx512) caps it, e.g. for benchmarking.
+ */
+enum Backend {
+  BACKEND_GENERIC,  //!< portable C++ kernels only
+  BACKEND_BMI2,  //!< BMI2/ADX field kernels, SHA-NI compression
+  BACKEND_AVX2,  //!< four-way AVX2 batched multiplications
+  BACKEND_AVX512,  //!< eight-way AVX-512 IFMA batched multiplications
+  BACKEND_AUTO  //!< best backend of the running cpu
+};
+
+/** Gets the backend in use.
+ * @return the highest backend the kernels are selected from
+ */
+Backend getBackend();
+
+/** Selects the backend, overriding ECL_BACKEND.
+ * Batched multiplications and hashes switch at once, fields keep the
+ * single element kernels they were created with.
+ * @note not thread safe, to be called before any other thread uses the
+ * library.
+ * @param[in] backend backend to use, BACKEND_AUTO for the best one
+ * @return ERR_OK, or ERR_NOT_IMPLEMENTED if the running cpu (or a build
+ * with FORCE_NO_ASM) does not support it, the backend being left unchanged
+ */
+ErrCode setBackend(Backend backend);
+
+}  // namespace ecl
+
+#endif  // ECL_DISPATCH_H_
@@ -10,6 +10,7 @@
 #ifndef ECL_FIELD_FP12_H_
 #define ECL_FIELD_FP12_H_
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 
@@ -24,32 +25,41 @@ using std::string;
 namespace ecl {
 namespace field {
 
-/** Degre 2 extension of a finite field over a prime p.
+/** Degre 12 extension of a finite field over a prime p, built on Fp6N.
+ * Fp12 is the NB_LIMBS instance.
+ * @tparam nb_limbs number of digits of a base field element
  */
-class Fp12 {
+template<int nb_limbs>
+class Fp12N {
  public:
+  /** Base prime field */
+  typedef GFpN<nb_limbs> GFp;
+  /** Degre 2 extension */
+  typedef Fp2N<nb_limbs> Fp2;
+  /** Base field */
+  typedef Fp6N<nb_limbs> Fp6;
   /** Field element */
-  typedef Fp6::Element Element[2];
+  typedef typename Fp6::Element Element[2];
   /**  Field double (unreduced result of a multiplication) */
-  typedef Fp6::Double Double[2];
+  typedef typename Fp6::Double Double[2];
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic in base 16
    */
-  Fp12(const string p);
+  Fp12N(const string p);
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic
    */
-  Fp12(const GFp::Element &p);
+  Fp12N(const typename GFp::Element &p);
 
   /** Destructor
    */
-  ~Fp12();
+  ~Fp12N();
 
   /** Sets an element to 0.
    * @param[out] res Element
@@ -89,6 +99,53 @@ class Fp12 {
    */
   bool isZero(const Element &a);
 
+  /** Gets the size of the binary representation of an element.
+   * @return 12 times the byte size of the base field
+   */
+  size_t getByteSize() {
+    return 12 * gfp->getByteSize();
+  }
+
+  /** Writes an element as its 12 GFp components, in index order
+   * (a[0][0][0][0], a[0][0][0][1], a[0][0][1][0] ...), each of them
+   * encoded by GFp::toBytes().
+   * @param[out] out buffer of getByteSize() bytes
+   * @param[in] a element
+   * @param[in] order byte order of the components
+   */
+  void toBytes(unsigned char *out, const Element &a, ByteOrder order);
+
+  /** Writes n elements as consecutive getByteSize() bytes blocks.
+   * @param[out] out buffer of n * getByteSize() bytes
+   * @param[in] a elements
+   * @param[in] n number of elements
+   * @param[in] order byte order of the components
+   */
+  void toBytes(unsigned char *out, const Element *a, size_t n,
+               ByteOrder order);
+
+  /** Reads an element written by toBytes().
+   * @param[out] res element
+   * @param[in] in buffer of getByteSize() bytes
+   * @param[in] order byte order of the components
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if a component is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, ByteOrder order);
+
+  /** Reads n elements written by toBytes().
+   * @param[out] res elements
+   * @param[in] in buffer of n * getByteSize() bytes
+   * @param[in] n number of elements
+   * @param[in] order byte order of the components
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if a component is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, size_t n,
+                    ByteOrder order);
+
   /** Performs res = a + b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -102,7 +159,7 @@ class Fp12 {
    * @param[in] b operand 2
    */
   void add(Element *res, const Element &a,
-           const GFp::Element &b);
+           const typename GFp::Element &b);
 
   /** Performs res = a + b.
    * @param[out] res result
@@ -191,7 +248,7 @@ class Fp12 {
    * @param[in] b operand 2
    */
   void mul(Element *res, const Element &a,
-           const GFp::Element &b);
+           const typename GFp::Element &b);
 
   /** Performs res = a^2.
    * @param[out] res result
@@ -211,6 +268,24 @@ class Fp12 {
    */
   void inv(Element *res, const Element &a);
 
+  /** Performs res[i] = 1/a[i] for i in [0, n[ with a single inversion.
+   * Allocation free, the intermediate products are stored in res.
+   * Zero elements are mapped to zero.
+   * @param[out] res results, must not overlap a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n);
+
+  /** Same as inv_batch(), the intermediate products are stored in scratch
+   * and wiped, which allows in place inversion.
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   * @param[in] scratch n elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n, Element *scratch);
+
   /** Performs res = a / b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -224,7 +299,7 @@ class Fp12 {
    * @param[in] e operand 2
    */
   void exp(Element *res, const Element &a,
-           const GFp::Element &e);
+           const typename GFp::Element &e);
 
   /** Performs res = a^(p^i) where p is the field characteristic.
    * @param[out] res result
@@ -246,8 +321,8 @@ class Fp12 {
    * @param[in] a0 field element
    * @param[in] a1 field element
    */
-  void init(Element *res, const Fp6::Element &a0,
-            const Fp6::Element &a1);
+  void init(Element *res, const typename Fp6::Element &a0,
+            const typename Fp6::Element &a1);
 
   /** Compares a and b
    * @param[in] a Fp2 Element
@@ -263,7 +338,7 @@ class Fp12 {
    * @return  1 if a != b
    * @return  0 if a == b
    */
-  int cmp(const Element &a, const GFp::Element &b);
+  int cmp(const Element &a, const typename GFp::Element &b);
 
   /** Compares a and b
    * @param[in] a Fp2 Double
@@ -296,7 +371,7 @@ class Fp12 {
   /** Get the characteristic of the field field.
    * @param[out] a field characteristic
    */
-  void get_characteristic(GFp::Element *a) {
+  void get_characteristic(typename GFp::Element *a) {
     gfp->get_characteristic(a);
   }
 
@@ -313,10 +388,13 @@ class Fp12 {
   Fp2 *fp2;  //<! base field
   Fp6 *fp6;  //<! base field
 
-  Fp2::Element gamma[3][5];
+  typename Fp2::Element gamma[3][5];
   void precomputeGamma();
 };
 
+/** Degre 12 extension of the prime field of NB_LIMBS digits */
+typedef Fp12N<NB_LIMBS> Fp12;
+
 }  // namespace field
 }  // namespace ecl
 
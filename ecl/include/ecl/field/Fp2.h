@@ -6,6 +6,7 @@
 #ifndef ECL_FIELD_FP2_H_
 #define ECL_FIELD_FP2_H_
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 
@@ -30,33 +31,39 @@ enum xsi_values {
   THREE_ONE  //!< 3 + i
 };
 
-/** Degre 2 extension of a finite field over a prime p.
+/** Degre 2 extension of a finite field over a prime p, whose base field
+ * elements are made of nb_limbs digits.
+ * Fp2 is the NB_LIMBS instance, see GFpN.
+ * @tparam nb_limbs number of digits of a base field element
  */
-class Fp2 {
+template<int nb_limbs>
+class Fp2N {
  public:
+  /** Base prime field */
+  typedef GFpN<nb_limbs> GFp;
 
   /** Field element */
-  typedef GFp::Element Element[2];
+  typedef typename GFp::Element Element[2];
   /**  Field double (unreduced result of a multiplication) */
-  typedef GFp::Double Double[2];
+  typedef typename GFp::Double Double[2];
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic in base 16
    */
-  Fp2(const string p);
+  Fp2N(const string p);
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic
    */
-  Fp2(const GFp::Element &p);
+  Fp2N(const typename GFp::Element &p);
 
   /** Destructor
    */
-  ~Fp2();
+  ~Fp2N();
 
   /** Sets an element to 0.
    * @param[out] res Element
@@ -96,6 +103,52 @@ class Fp2 {
    */
   bool isZero(const Element &a);
 
+  /** Gets the size of the binary representation of an element.
+   * @return 2 times the byte size of the base field
+   */
+  size_t getByteSize() {
+    return 2 * gfp->getByteSize();
+  }
+
+  /** Writes an element as its 2 GFp components, a[0] then a[1], each of them
+   * encoded by GFp::toBytes().
+   * @param[out] out buffer of getByteSize() bytes
+   * @param[in] a element
+   * @param[in] order byte order of the components
+   */
+  void toBytes(unsigned char *out, const Element &a, ByteOrder order);
+
+  /** Writes n elements as consecutive getByteSize() bytes blocks.
+   * @param[out] out buffer of n * getByteSize() bytes
+   * @param[in] a elements
+   * @param[in] n number of elements
+   * @param[in] order byte order of the components
+   */
+  void toBytes(unsigned char *out, const Element *a, size_t n,
+               ByteOrder order);
+
+  /** Reads an element written by toBytes().
+   * @param[out] res element
+   * @param[in] in buffer of getByteSize() bytes
+   * @param[in] order byte order of the components
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if a component is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, ByteOrder order);
+
+  /** Reads n elements written by toBytes().
+   * @param[out] res elements
+   * @param[in] in buffer of n * getByteSize() bytes
+   * @param[in] n number of elements
+   * @param[in] order byte order of the components
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if a component is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, size_t n,
+                    ByteOrder order);
+
   /** Performs res = a + b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -103,12 +156,23 @@ class Fp2 {
    */
   void add(Element *res, const Element &a, const Element &b);
 
+  /** Performs res = a + b, interface of GFp::add_lazy().
+   * The result is reduced : the Karatsuba sums of mul() and sqr() are
+   * already lazy, so their operands shall be reduced.
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void add_lazy(Element *res, const Element &a, const Element &b) {
+    add(res, a, b);
+  }
+
   /** Performs res = a + b.
    * @param[out] res result
    * @param[in] a operand 1
    * @param[in] b operand 2
    */
-  void add(Element *res, const Element &a, const GFp::Element &b);
+  void add(Element *res, const Element &a, const typename GFp::Element &b);
 
   /** Performs res = a + b.
    * @param[out] res result
@@ -145,6 +209,16 @@ class Fp2 {
    */
   void sub(Double *res, const Double &a, const Double &b);
 
+  /** Performs res = a - b, interface of GFp::sub_lazy().
+   * The result is reduced, see add_lazy().
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void sub_lazy(Element *res, const Element &a, const Element &b) {
+    sub(res, a, b);
+  }
+
   /** Performs res = - a .
    * @param[out] res result
    * @param[in] a operand 1
@@ -196,7 +270,7 @@ class Fp2 {
    * @param[in] a operand 1
    * @param[in] b operand 2
    */
-  void mul(Element *res, const Element &a, const GFp::Element &b);
+  void mul(Element *res, const Element &a, const typename GFp::Element &b);
 
   /** Performs res = a^2.
    * @param[out] res result
@@ -216,6 +290,40 @@ class Fp2 {
    */
   void inv(Element *res, const Element &a);
 
+  /** Performs res[i] = 1/a[i] for i in [0, n[ with a single inversion.
+   * Allocation free, the intermediate products are stored in res.
+   * Zero elements are mapped to zero.
+   * @param[out] res results, must not overlap a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n);
+
+  /** Same as inv_batch(), the intermediate products are stored in scratch
+   * and wiped, which allows in place inversion.
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   * @param[in] scratch n elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n, Element *scratch);
+
+  /** Performs res[i] = a[i] * b[i] for i in [0, n[.
+   * The products of the components are computed by GFp::mul_batch().
+   * @param[out] res results, may alias a or b
+   * @param[in] a operands 1
+   * @param[in] b operands 2
+   * @param[in] n number of elements
+   */
+  void mul_batch(Element *res, const Element *a, const Element *b, size_t n);
+
+  /** Performs res[i] = a[i] * a[i] for i in [0, n[, see mul_batch().
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void sqr_batch(Element *res, const Element *a, size_t n);
+
   /** Performs res = a / b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -228,7 +336,7 @@ class Fp2 {
    * @param[in] a operand 1
    * @param[in] e operand 2
    */
-  void exp(Element *res, const Element &a, const GFp::Element &e);
+  void exp(Element *res, const Element &a, const typename GFp::Element &e);
 
   /** Performs res = a^(p^i) where p is the field characteristic.
    * @param[out] res result
@@ -250,8 +358,8 @@ class Fp2 {
    * @param[in] a0 field element
    * @param[in] a1 field element
    */
-  void init(Element *res, const GFp::Element &a0,
-            const GFp::Element &a1);
+  void init(Element *res, const typename GFp::Element &a0,
+            const typename GFp::Element &a1);
 
   /** Compares a and b
    * @param[in] a Fp2 Element
@@ -267,7 +375,7 @@ class Fp2 {
    * @return  1 if a != b
    * @return  0 if a == b
    */
-  int cmp(const Element &a, const GFp::Element &b);
+  int cmp(const Element &a, const typename GFp::Element &b);
 
   /** Compares a and b
    * @param[in] a Fp2 Double
@@ -329,7 +437,7 @@ class Fp2 {
   /** Get the characteristic of the field field.
    * @param[out] a field characteristic
    */
-  void get_characteristic(GFp::Element *a) {
+  void get_characteristic(typename GFp::Element *a) {
     gfp->get_characteristic(a);
   }
 
@@ -356,6 +464,9 @@ class Fp2 {
 
 };
 
+/** Degre 2 extension of the prime field of NB_LIMBS digits */
+typedef Fp2N<NB_LIMBS> Fp2;
+
 }  // namespace field
 }  // namespace ecl
 
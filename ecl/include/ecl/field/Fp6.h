@@ -6,6 +6,7 @@
 #ifndef ECL_FIELD_FP6_H_
 #define ECL_FIELD_FP6_H_
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 
@@ -19,32 +20,39 @@ using std::string;
 namespace ecl {
 namespace field {
 
-/** Degre 6 extension of a finite field over a prime p.
+/** Degre 6 extension of a finite field over a prime p, built on Fp2N.
+ * Fp6 is the NB_LIMBS instance.
+ * @tparam nb_limbs number of digits of a base field element
  */
-class Fp6 {
+template<int nb_limbs>
+class Fp6N {
  public:
+  /** Base prime field */
+  typedef GFpN<nb_limbs> GFp;
+  /** Base field */
+  typedef Fp2N<nb_limbs> Fp2;
   /** Field element */
-  typedef Fp2::Element Element[3];
+  typedef typename Fp2::Element Element[3];
   /**  Field double (unreduced result of a multiplication) */
-  typedef Fp2::Double Double[3];
+  typedef typename Fp2::Double Double[3];
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic in base 16
    */
-  Fp6(const string p);
+  Fp6N(const string p);
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic
    */
-  Fp6(const GFp::Element &p);
+  Fp6N(const typename GFp::Element &p);
 
   /** Destructor
    */
-  ~Fp6();
+  ~Fp6N();
 
   /** Sets an element to 0.
    * @param[out] res Element
@@ -96,7 +104,7 @@ class Fp6 {
    * @param[in] a operand 1
    * @param[in] b operand 2
    */
-  void add(Element *res, const Element &a, const GFp::Element &b);
+  void add(Element *res, const Element &a, const typename GFp::Element &b);
 
   /** Performs res = a + b.
    * @param[out] res result
@@ -177,7 +185,7 @@ class Fp6 {
    * @param[in] a operand 1
    * @param[in] b operand 2
    */
-  void mul(Element *res, const Element &a, const Fp2::Element &b);
+  void mul(Element *res, const Element &a, const typename Fp2::Element &b);
 
   /** Performs res = a * b.
    * @param[out] res result
@@ -191,7 +199,7 @@ class Fp6 {
    * @param[in] a operand 1
    * @param[in] b operand 2
    */
-  void mul(Element *res, const Element &a, const GFp::Element &b);
+  void mul(Element *res, const Element &a, const typename GFp::Element &b);
 
   /** Performs res = a^2.
    * @param[out] res result
@@ -211,6 +219,24 @@ class Fp6 {
    */
   void inv(Element *res, const Element &a);
 
+  /** Performs res[i] = 1/a[i] for i in [0, n[ with a single inversion.
+   * Allocation free, the intermediate products are stored in res.
+   * Zero elements are mapped to zero.
+   * @param[out] res results, must not overlap a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n);
+
+  /** Same as inv_batch(), the intermediate products are stored in scratch
+   * and wiped, which allows in place inversion.
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   * @param[in] scratch n elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n, Element *scratch);
+
   /** Performs res = a / b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -223,7 +249,7 @@ class Fp6 {
    * @param[in] a operand 1
    * @param[in] e operand 2
    */
-  void exp(Element *res, const Element &a, const GFp::Element &e);
+  void exp(Element *res, const Element &a, const typename GFp::Element &e);
 
   /** Performs res = a^(p^i) where p is the field characteristic.
    * @param[out] res result
@@ -247,8 +273,8 @@ class Fp6 {
    * @param[in] a1 Fp2 element
    * @param[in] a2 Fp2 element
    */
-  void init(Element *res, const Fp2::Element &a0,
-            const Fp2::Element &a1, const Fp2::Element &a2);
+  void init(Element *res, const typename Fp2::Element &a0,
+            const typename Fp2::Element &a1, const typename Fp2::Element &a2);
 
   /** Compares a and b
    * @param[in] a Fp2 Element
@@ -264,7 +290,7 @@ class Fp6 {
    * @return  1 if a != b
    * @return  0 if a == b
    */
-  int cmp(const Element &a, const GFp::Element &b);
+  int cmp(const Element &a, const typename GFp::Element &b);
 
   /** Compares a and b
    * @param[in] a Fp2 Double
@@ -311,7 +337,7 @@ class Fp6 {
   /** Get the characteristic of the field field.
    * @param[out] a field characteristic
    */
-  void get_characteristic(GFp::Element *a) {
+  void get_characteristic(typename GFp::Element *a) {
     gfp->get_characteristic(a);
   }
   ;
@@ -329,6 +355,9 @@ class Fp6 {
   Fp2 *fp2;  //<! Fp2 base field
 };
 
+/** Degre 6 extension of the prime field of NB_LIMBS digits */
+typedef Fp6N<NB_LIMBS> Fp6;
+
 }  // namespace field
 }  // namespace ecl
 
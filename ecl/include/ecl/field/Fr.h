@@ -0,0 +1,85 @@
+/**
+ * @file Fr.h
+ *
+ * Part of ecl.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef ECL_FIELD_FR_H_
+#define ECL_FIELD_FR_H_
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+#include "ecl/bigint/FixedSizedInt.h"
+#include "ecl/field/GFp.h"
+
+namespace ecl {
+namespace field {
+
+/** Scalar field of a curve, integers modulo the order r of the group.
+ * Elements are in Montgomery form as GFp ones, so that scalar arithmetic
+ * (mul, inv, inv_batch, ...) is the one of GFp. Fr adds the conversions
+ * between elements and the plain integers used as multipliers by the curve
+ * scalar multiplications, and the reduction of double size integers
+ * (hash to scalar) by Barrett reduction.
+ * @note the most significant digit of r shall not be zero.
+ */
+class Fr : public GFp {
+ public:
+  /** Constructor.
+   * @note: there is no primality check on r !
+   * @param[in] r order of the group
+   */
+  Fr(const Element &r);
+
+  /** Converts a plain integer to an element.
+   * @param[out] res k mod r
+   * @param[in] k integer, any value
+   */
+  void fromInt(Element *res, const Element &k);
+
+  /** Converts an element to a plain integer, e.g. a multiplier for
+   * FpnCurve::mul().
+   * @param[out] k integer in [0, r[
+   * @param[in] a element
+   */
+  void toInt(Element *k, const Element &a);
+
+  /** Reduces a double size integer modulo r, constant time.
+   * @param[out] k plain integer h mod r
+   * @param[in] h integer, e.g. 512 bits hash output for a 256 bits order
+   */
+  void reduce_wide(Element *k, const Double &h);
+
+  /** Converts a double size integer to an element (hash to scalar).
+   * @param[out] res h mod r
+   * @param[in] h integer, e.g. 512 bits hash output for a 256 bits order
+   */
+  void fromWide(Element *res, const Double &h);
+
+  /** Gets the wNAF recoding of an element, see FixedSizedInt::get_wNAF().
+   * @param[out] wNaf digits, least significant first, at least
+   * NB_LIMBS * DIGIT_BITS + 1 entries
+   * @param[out] wNaf_sz number of digits
+   * @param[in] a element
+   * @param[in] w size of the window
+   */
+  void get_wNAF(int *wNaf, int *wNaf_sz, const Element &a, int w);
+
+  /** Converts a signed digits recoding (e.g. wNAF) back to an element.
+   * @param[out] res sum of wNaf[i].2^i mod r
+   * @param[in] wNaf digits, least significant first
+   * @param[in] wNaf_sz number of digits
+   */
+  void fromWNAF(Element *res, const int *wNaf, int wNaf_sz);
+
+ private:
+  Double mu_;  //!< Barrett constant of r
+};
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_FIELD_FR_H_
@@ -10,6 +10,7 @@
 #ifndef ECL_FIELD_GFP_H_
 #define ECL_FIELD_GFP_H_
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 
@@ -26,32 +27,41 @@ namespace ecl {
  */
 namespace field {
 
-/** Implementation of prime field of degre 1.
+/** Implementation of prime field of degre 1, whose elements are made of
+ * nb_limbs digits.
+ * GFp is the NB_LIMBS instance. Fields of other sizes, e.g. GFpN<6> for 384
+ * bits primes (BLS12-381) with 64 bits digits, may be used in the same
+ * process, and so may the extension fields built on them (see Fp2N).
+ * The BMI2/ADX, P-256 and batch kernels and the safegcd inversion are
+ * specific to 4 limbs of 64 bits, other sizes use the comba kernels and
+ * Fermat inversion. Instantiated for 4, 6 and 8 limbs.
+ * @tparam nb_limbs number of digits of an element
  */
-class GFp {
+template<int nb_limbs>
+class GFpN {
  public:
   /** Field element */
-  typedef FixedSizedInt<NB_LIMBS> Element;
+  typedef FixedSizedInt<nb_limbs> Element;
   /** Field double (unreduced result of a multiplication) */
-  typedef FixedSizedInt<2 * NB_LIMBS> Double;
+  typedef FixedSizedInt<2 * nb_limbs> Double;
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic in base 16
    */
-  GFp(const string p);
+  GFpN(const string p);
 
   /** Constructor.
    * Sets the characteristic of the field
    * @note: there is no primality check on p !
    * @param[in] p characteristic
    */
-  GFp(const Element &p);
+  GFpN(const Element &p);
 
   /** Destructor
    */
-  ~GFp();
+  ~GFpN();
 
   /** Reads element from radix 16 representation
    * @param[out] res resulting element
@@ -61,6 +71,53 @@ class GFp {
    */
   ErrCode fromString(Element *res, const string str);
 
+  /** Gets the size of the binary representation of an element.
+   * @return number of bytes of p
+   */
+  size_t getByteSize() const {
+    return byte_size_;
+  }
+
+  /** Writes an element as a getByteSize() bytes integer in [0, p[.
+   * @param[out] out buffer of getByteSize() bytes
+   * @param[in] a element
+   * @param[in] order byte order
+   */
+  void toBytes(unsigned char *out, const Element &a, ByteOrder order);
+
+  /** Writes n elements as consecutive getByteSize() bytes integers.
+   * The conversions from Montgomery form are batched, see mul_batch().
+   * @param[out] out buffer of n * getByteSize() bytes
+   * @param[in] a elements
+   * @param[in] n number of elements
+   * @param[in] order byte order
+   */
+  void toBytes(unsigned char *out, const Element *a, size_t n,
+               ByteOrder order);
+
+  /** Reads an element from a getByteSize() bytes integer.
+   * @param[out] res element
+   * @param[in] in buffer of getByteSize() bytes
+   * @param[in] order byte order
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if the integer is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, ByteOrder order);
+
+  /** Reads n elements from consecutive getByteSize() bytes integers.
+   * The conversions to Montgomery form are batched, see mul_batch().
+   * @param[out] res elements
+   * @param[in] in buffer of n * getByteSize() bytes
+   * @param[in] n number of elements
+   * @param[in] order byte order
+   * @return ERR_OK if success
+   * @return ERR_INVALID_VALUE if an integer is not lower than p, res being
+   * then left unchanged
+   */
+  ErrCode fromBytes(Element *res, const unsigned char *in, size_t n,
+                    ByteOrder order);
+
   /** Sets an element to 0.
    * @param[out] a an Element
    */
@@ -115,6 +172,18 @@ class GFp {
    */
   void add_nr(Element *res, const Element &a, const Element b);
 
+  /** Performs res = a + b with lazy reduction.
+   * If p < R/4, no reduction is performed and res lies in [0, 2p].
+   * Otherwise it is the same as add().
+   * A lazy result shall only be used as an operand of mul() or sqr(), the
+   * product of both operands being lower than p.R (i.e. both lazy or one
+   * lazy and one reduced). Debug builds check this bound in reduce().
+   * @param[out] res result
+   * @param[in] a operand 1, at most p (opp(0) is p)
+   * @param[in] b operand 2, at most p
+   */
+  void add_lazy(Element *res, const Element &a, const Element &b);
+
   /** Performs res = a + b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -157,6 +226,15 @@ class GFp {
    */
   void sub(Double *res, const Double &a, const Double &b);
 
+  /** Performs res = a - b with lazy reduction, see add_lazy().
+   * If p < R/4, res = a + (p - b) lies in [0, 2p], without branch.
+   * Otherwise it is the same as sub().
+   * @param[out] res result
+   * @param[in] a operand 1, at most p
+   * @param[in] b operand 2, at most p
+   */
+  void sub_lazy(Element *res, const Element &a, const Element &b);
+
   /** Performs res = a - b without reduction.
    * @note: result may be negative... use with caution.
    * @param[out] res result
@@ -301,6 +379,27 @@ class GFp {
    */
   ErrCode sqrt(Element *res, const Element &a);
 
+  /** Compute the square root of the ratio u/v.
+   * Needs a single exponentiation if p mod 4 == 3. Otherwise falls back to
+   * an inversion and sqrt() (Tonelli-Shanks if p mod 8 == 1).
+   * @param[out] res \f$ res = \sqrt{u/v} \f$, unchanged on error
+   * @param[in] u numerator
+   * @param[in] v denominator
+   * @return ERR_OK if success
+   * @return ERR_NOT_SQUARE if u/v is a quadratic non residue
+   * @return ERR_INVALID_VALUE if v is zero
+   */
+  ErrCode sqrt_ratio(Element *res, const Element &u, const Element &v);
+
+  /** Compute the inverse square root of element a.
+   * @param[out] res \f$ res = 1/\sqrt{a} \f$, unchanged on error
+   * @param[in] a field element
+   * @return ERR_OK if success
+   * @return ERR_NOT_SQUARE if a is a quadratic non residue
+   * @return ERR_INVALID_VALUE if a is zero
+   */
+  ErrCode inv_sqrt(Element *res, const Element &a);
+
   /** Compute the square root of element a (slow).
    * This is the generic version which does not dependof special prime form
    * (called by sqrt() anyway).
@@ -313,11 +412,56 @@ class GFp {
   ErrCode tonelli_shanks(Element *res, const Element &a);
 
   /** Performs res = 1 / a.
+   * Constant time, inv(0) = 0.
    * @param[out] res result
    * @param[in] a operand
    */
   void inv(Element *res, const Element &a);
 
+  /** Performs res = 1 / a in variable time.
+   * Faster than inv(), to be used on public values only. inv_vartime(0) = 0.
+   * @param[out] res result
+   * @param[in] a operand
+   */
+  void inv_vartime(Element *res, const Element &a);
+
+  /** Performs res[i] = 1/a[i] for i in [0, n[ with a single inversion.
+   * Allocation free, the intermediate products are stored in res.
+   * Zero elements are mapped to zero.
+   * @param[out] res results, must not overlap a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n);
+
+  /** Same as inv_batch(), the intermediate products are stored in scratch
+   * and wiped, which allows in place inversion.
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   * @param[in] scratch n elements
+   */
+  void inv_batch(Element *res, const Element *a, size_t n, Element *scratch);
+
+  /** Performs res[i] = a[i] * b[i] for i in [0, n[.
+   * Meant for throughput on many independent products: eight elements at a
+   * time with AVX-512 IFMA, then four at a time with AVX2, one at a time
+   * with mul() for the rest, depending on the backend (see ecl/dispatch.h).
+   * P-256 on BMI2/ADX cpus skips the AVX2 kernel.
+   * @param[out] res results, may alias a or b
+   * @param[in] a operands 1
+   * @param[in] b operands 2
+   * @param[in] n number of elements
+   */
+  void mul_batch(Element *res, const Element *a, const Element *b, size_t n);
+
+  /** Performs res[i] = a[i] * a[i] for i in [0, n[, see mul_batch().
+   * @param[out] res results, may alias a
+   * @param[in] a operands
+   * @param[in] n number of elements
+   */
+  void sqr_batch(Element *res, const Element *a, size_t n);
+
   /** Performs res = a / b.
    * @param[out] res result
    * @param[in] a operand 1
@@ -357,22 +501,48 @@ class GFp {
   /** Get the base field.
    * This field is the prime field ( GFp ).
    */
-  GFp *getBasePrimeField() {
+  GFpN *getBasePrimeField() {
     return this;
   }
 
- private:
+ protected:
   Element p_;
   Element R_;
   Element R2_;
   Element R3_;
   Double Rp_;
   ecl_digit m_;
+  bool use_mulx_;  //!< whether BMI2/ADX kernels are used for mul, sqr and reduce
+  bool p256_;  //!< whether p is the NIST P-256 prime, reduced by p256_reduce
+  bool lazy_;  //!< whether p < R/4, add_lazy and sub_lazy skip the reduction
+  size_t byte_size_;  //!< number of bytes of p
+
+  /** Sliding window schedule of a fixed exponent.
+   * Step 0 loads a^(2.idx[0]+1), step i > 0 performs sqr[i] squarings then
+   * multiplies by a^(2.idx[i]+1), tail squarings end the exponentiation.
+   */
+  struct FixedExp {
+    int len;  //!< number of steps, 0 if exponent is 0
+    int tail;  //!< final squarings
+    uint16_t sqr[nb_limbs * DIGIT_BITS];  //!< squarings before each step
+    uint8_t idx[nb_limbs * DIGIT_BITS];  //!< odd power used by each step
+  };
+  FixedExp exp_pm1s2_;  //!< (p-1)/2, Euler criterion
+  FixedExp exp_sqrt_;  //!< (p-3)/4 if p = 3 mod 4, (p-5)/8 if p = 5 mod 8
+  FixedExp exp_pm1s3_;  //!< (p-1)/3, cubic residuosity
 
   void init();
+  void init_exp();
+  void exp_setup(FixedExp *s, const Element &e);
+  void exp_fixed(Element *res, const Element &a, const FixedExp &s);
   ErrCode montSetup(ecl_digit *rho, const Element &a);
+  bool isP256(const Element &p);
+  void p256_reduce(Element *res, const ecl_digit *a);
 };
 
+/** Prime field of NB_LIMBS digits, the base field of the curves */
+typedef GFpN<NB_LIMBS> GFp;
+
 }  // namespace field
 }  // namespace ecl
 
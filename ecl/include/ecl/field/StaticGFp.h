@@ -0,0 +1,480 @@
+/**
+ * @file StaticGFp.h
+ *
+ * Part of ecl.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef ECL_FIELD_STATICGFP_H_
+#define ECL_FIELD_STATICGFP_H_
+
+#include <string>
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+#include "ecl/bigint/FixedSizedInt.h"
+
+using std::string;
+
+namespace ecl {
+namespace field {
+
+/** Montgomery constants of a prime field.
+ */
+struct MontgomeryConstants {
+  ecl_digit p[NB_LIMBS];  //!< characteristic
+  ecl_digit R[NB_LIMBS];  //!< R mod p, with R = 2^(NB_LIMBS*DIGIT_BITS)
+  ecl_digit R2[NB_LIMBS];  //!< R^2 mod p
+  ecl_digit R3[NB_LIMBS];  //!< R^3 mod p
+  ecl_digit m;  //!< -1/p mod 2^DIGIT_BITS
+  bool no_carry;  //!< p most significant digit < 2^(DIGIT_BITS-1) - 1
+};
+
+/** Doubles a modulo p, a < p.
+ */
+constexpr void montgomery_double(ecl_digit *a, const ecl_digit *p) {
+  ecl_digit t[NB_LIMBS] = { };
+  ecl_digit carry = 0, borrow = 0;
+  ecl_word w = 0;
+  int i = 0;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = ((ecl_word) a[i] << 1) + carry;
+    t[i] = (ecl_digit) w;
+    carry = (ecl_digit) (w >> DIGIT_BITS);
+  }
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = (ecl_word) t[i] - p[i] - borrow;
+    a[i] = (ecl_digit) w;
+    borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+  }
+  if (borrow && !carry) {
+    for (i = 0; i < NB_LIMBS; i++) {
+      a[i] = t[i];
+    }
+  }
+}
+
+/** Computes the Montgomery constants of a prime given in 64 bits words,
+ * least significant first.
+ */
+constexpr MontgomeryConstants montgomery_constants(uint64_t p0, uint64_t p1,
+                                                   uint64_t p2, uint64_t p3) {
+  MontgomeryConstants c = { };
+  const uint64_t w[4] = { p0, p1, p2, p3 };
+  ecl_digit x = 0, b = 0;
+  int i = 0;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    c.p[i] = (ecl_digit) (w[(i * DIGIT_BITS) / 64] >> ((i * DIGIT_BITS) % 64));
+  }
+
+  /* m = -1/p mod 2^DIGIT_BITS, see GFp::montSetup() */
+  b = c.p[0];
+  x = (((b + 2) & 4) << 1) + b;
+  x *= 2 - b * x;
+  x *= 2 - b * x;
+  x *= 2 - b * x;
+#ifdef DIGIT_64
+  x *= 2 - b * x;
+#endif
+  c.m = 0 - x;
+
+  /* R, R^2 and R^3 mod p by consecutive doublings of 1 */
+  c.R[0] = 1;
+  for (i = 0; i < NB_LIMBS * DIGIT_BITS; i++) {
+    montgomery_double(c.R, c.p);
+  }
+  for (i = 0; i < NB_LIMBS; i++) {
+    c.R2[i] = c.R[i];
+  }
+  for (i = 0; i < NB_LIMBS * DIGIT_BITS; i++) {
+    montgomery_double(c.R2, c.p);
+  }
+  for (i = 0; i < NB_LIMBS; i++) {
+    c.R3[i] = c.R2[i];
+  }
+  for (i = 0; i < NB_LIMBS * DIGIT_BITS; i++) {
+    montgomery_double(c.R3, c.p);
+  }
+
+  c.no_carry = c.p[NB_LIMBS - 1] < ((((ecl_digit) 1) << (DIGIT_BITS - 1)) - 1);
+  return c;
+}
+
+/** BN prime for t = 0x3FC0100000000000 (beuchat_254_curve).
+ */
+struct Beuchat254Prime {
+  static constexpr MontgomeryConstants constants() {
+    return montgomery_constants(0x7e80600000000001ULL, 0x7d023f4018000001ULL,
+                                0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL);
+  }
+};
+
+/** BN prime for t = -0x4080000000000001 (aranha_254_curve).
+ */
+struct Aranha254Prime {
+  static constexpr MontgomeryConstants constants() {
+    return montgomery_constants(0xa700000000000013ULL, 0x6121000000000013ULL,
+                                0xba344d8000000008ULL, 0x2523648240000001ULL);
+  }
+};
+
+/** BN prime for t = -0x600000000000219B (naering_256_curve).
+ */
+struct Naering256Prime {
+  static constexpr MontgomeryConstants constants() {
+    return montgomery_constants(0x42bc818f95e3e6afULL, 0xb0001f44b6b88bf1ULL,
+                                0x2200000085fd5480ULL, 0xb64000000000ff2fULL);
+  }
+};
+
+/** NIST P-256 prime, 2^256 - 2^224 + 2^192 + 2^96 - 1.
+ */
+struct P256Prime {
+  static constexpr MontgomeryConstants constants() {
+    return montgomery_constants(0xffffffffffffffffULL, 0x00000000ffffffffULL,
+                                0x0000000000000000ULL, 0xffffffff00000001ULL);
+  }
+};
+
+#if defined(ARCH_X86_64)
+/** Montgomery multiplication with the BMI2/ADX kernels of GFp.
+ * Only to be called if the cpu supports them, see StaticGFp::mul().
+ * @param[out] res a.b / R mod p
+ * @param[in] a operand 1
+ * @param[in] b operand 2
+ * @param[in] p characteristic
+ * @param[in] m -1/p mod 2^DIGIT_BITS
+ */
+void static_gfp_mulx_montmul(ecl_digit *res, const ecl_digit *a,
+                             const ecl_digit *b, const ecl_digit *p,
+                             ecl_digit m);
+
+/** Montgomery square with the BMI2/ADX kernels of GFp.
+ * Only to be called if the cpu supports them, see StaticGFp::sqr().
+ * @param[out] res a^2 / R mod p
+ * @param[in] a operand
+ * @param[in] p characteristic
+ * @param[in] m -1/p mod 2^DIGIT_BITS
+ */
+void static_gfp_mulx_sqr(ecl_digit *res, const ecl_digit *a,
+                         const ecl_digit *p, ecl_digit m);
+#endif
+
+/** Prime field whose characteristic is known at compile time.
+ * Same element representation (Montgomery) and same interface as GFp for
+ * the base operations, but the modulus and the Montgomery constants are
+ * compile time constants : no pointer is followed to reach them. The object
+ * only holds the kernel choice made at construction, like GFp, and the
+ * arithmetic is inline so that callers see the constant modulus.
+ * Instantiated for Beuchat254Prime, Aranha254Prime, Naering256Prime and
+ * P256Prime.
+ * @tparam Params class providing a constexpr constants() method
+ */
+template<class Params>
+class StaticGFp {
+ public:
+  /** Field element */
+  typedef FixedSizedInt<NB_LIMBS> Element;
+
+  /** Montgomery constants */
+  static constexpr MontgomeryConstants k_ = Params::constants();
+
+  /** Basic constructor.
+   * Selects the multiplication kernels of the running cpu, see
+   * ecl/dispatch.h.
+   */
+  StaticGFp();
+
+  /** Reads element from radix 16 representation
+   * @param[out] res resulting element
+   * @param[in] str string representation
+   *
+   * @return ERR_INVALID_VALUE if string representation is too long
+   */
+  ErrCode fromString(Element *res, const string str);
+
+  /** Sets an element to 0.
+   * @param[out] a an Element
+   */
+  void zero(Element *a);
+
+  /** Sets an element to 1.
+   * @param[out] a an Element
+   */
+  void one(Element *a);
+
+  /** Sets an element to a specific value.
+   * @param[out] a an Element
+   * @param[in] v value
+   */
+  void set(Element *a, const int v);
+
+  /** Get random element.
+   * @param[out] res random element
+   * @param f_rng random generation function
+   * @param p_rng RNG internal state
+   */
+  void rand(Element *res, int (*f_rng)(unsigned char *, int, void *),
+            void *p_rng);
+
+  /** Copies an element.
+   * @param[out] res copy
+   * @param[in] a element to copy
+   */
+  void copy(Element *res, const Element &a);
+
+  /** Tells whether an element is 1.
+   * @param[in] a an Element
+   * @return true if a == 1
+   */
+  bool isOne(const Element &a);
+
+  /** Tells whether an element is 0.
+   * @param[in] a an Element
+   * @return true if a == 0
+   */
+  bool isZero(const Element &a);
+
+  /** Compares a and b.
+   * @param[in] a GFp Element
+   * @param[in] b GFp Element
+   * @return -1 if a > b
+   * @return  1 if a < b
+   * @return  0 if a == b
+   */
+  int cmp(const Element &a, const Element &b);
+
+  /** Performs res = a + b.
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void add(Element *res, const Element &a, const Element &b);
+
+  /** Performs res = a - b.
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void sub(Element *res, const Element &a, const Element &b);
+
+  /** Performs res = -a.
+   * @param[out] res result
+   * @param[in] a operand
+   */
+  void opp(Element *res, const Element &a);
+
+  /** Performs res = a * b.
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void mul(Element *res, const Element &a, const Element &b);
+
+  /** Performs res = a^2.
+   * @param[out] res result
+   * @param[in] a operand
+   */
+  void sqr(Element *res, const Element &a);
+
+  /** Performs res = a^e.
+   * @param[out] res result
+   * @param[in] a operand
+   * @param[in] e exponent
+   */
+  void exp(Element *res, const Element &a, const Element &e);
+
+  /** Performs res = 1 / a.
+   * Constant time, inv(0) = 0.
+   * @param[out] res result
+   * @param[in] a operand
+   */
+  void inv(Element *res, const Element &a);
+
+  /** Performs res = a / b.
+   * @param[out] res result
+   * @param[in] a operand 1
+   * @param[in] b operand 2
+   */
+  void div(Element *res, const Element &a, const Element &b);
+
+  /** Returns extension degre
+   *
+   */
+  static int getExtensionDegre() {
+    return 1;
+  }
+
+  /** Returns the characteristic.
+   * @param[out] p characteristic
+   */
+  void get_characteristic(Element *p);
+
+ private:
+  bool use_mulx_;  //!< whether BMI2/ADX kernels are used for mul and sqr
+};
+
+template<class Params>
+constexpr MontgomeryConstants StaticGFp<Params>::k_;
+
+template<class Params>
+inline void StaticGFp<Params>::zero(Element *a) {
+  a->zero();
+}
+
+template<class Params>
+inline void StaticGFp<Params>::copy(Element *res, const Element &a) {
+  res->copy(a);
+}
+
+template<class Params>
+inline bool StaticGFp<Params>::isZero(const Element &a) {
+  return a.isZero();
+}
+
+/* res = t - p if t >= p (or carry), t otherwise ; in constant time */
+template<class Params>
+inline void static_gfp_final_sub(ecl_digit *res, const ecl_digit *t,
+                                 ecl_digit carry) {
+  ecl_digit s[NB_LIMBS], mask;
+  ecl_word w;
+  ecl_digit borrow = 0;
+  int i;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = (ecl_word) t[i] - StaticGFp<Params>::k_.p[i] - borrow;
+    s[i] = (ecl_digit) w;
+    borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+  }
+  /* keep t only if t < p and no carry */
+  mask = 0 - (borrow & (carry ^ 1));
+  for (i = 0; i < NB_LIMBS; i++) {
+    res[i] = (t[i] & mask) | (s[i] & ~mask);
+  }
+}
+
+template<class Params>
+inline void StaticGFp<Params>::add(Element *res, const Element &a,
+                                   const Element &b) {
+  ecl_digit t[NB_LIMBS], carry = 0;
+  ecl_word w;
+  int i;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = (ecl_word) a.val[i] + b.val[i] + carry;
+    t[i] = (ecl_digit) w;
+    carry = (ecl_digit) (w >> DIGIT_BITS);
+  }
+  if (k_.no_carry) {
+    carry = 0;  // a + b < 2p < R
+  }
+  static_gfp_final_sub<Params>(res->val, t, carry);
+}
+
+template<class Params>
+inline void StaticGFp<Params>::sub(Element *res, const Element &a,
+                                   const Element &b) {
+  ecl_digit t[NB_LIMBS], borrow = 0, carry = 0, mask;
+  ecl_word w;
+  int i;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = (ecl_word) a.val[i] - b.val[i] - borrow;
+    t[i] = (ecl_digit) w;
+    borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+  }
+  /* add p back on borrow */
+  mask = 0 - borrow;
+  for (i = 0; i < NB_LIMBS; i++) {
+    w = (ecl_word) t[i] + (k_.p[i] & mask) + carry;
+    res->val[i] = (ecl_digit) w;
+    carry = (ecl_digit) (w >> DIGIT_BITS);
+  }
+}
+
+template<class Params>
+inline void StaticGFp<Params>::opp(Element *res, const Element &a) {
+  Element z;
+  sub(res, z, a);
+}
+
+/* Montgomery multiplication, CIOS method.
+ * If the most significant digit of p is below 2^(DIGIT_BITS-1) - 1, the
+ * intermediate result fits in NB_LIMBS digits and the extra carry digits
+ * are dropped.
+ */
+template<class Params>
+inline void static_gfp_montmul(ecl_digit *res, const ecl_digit *a,
+                               const ecl_digit *b) {
+  typedef StaticGFp<Params> F;
+  ecl_digit t[NB_LIMBS + 2] = { };
+  ecl_digit c, hi = 0, m;
+  ecl_word w;
+  int i, j;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    /* t += a.b[i] */
+    c = 0;
+    for (j = 0; j < NB_LIMBS; j++) {
+      w = (ecl_word) a[j] * b[i] + t[j] + c;
+      t[j] = (ecl_digit) w;
+      c = (ecl_digit) (w >> DIGIT_BITS);
+    }
+    if (F::k_.no_carry) {
+      hi = c;
+    } else {
+      w = (ecl_word) t[NB_LIMBS] + c;
+      t[NB_LIMBS] = (ecl_digit) w;
+      t[NB_LIMBS + 1] = (ecl_digit) (w >> DIGIT_BITS);
+    }
+    /* t = (t + m.p) / 2^DIGIT_BITS */
+    m = t[0] * F::k_.m;
+    w = (ecl_word) m * F::k_.p[0] + t[0];
+    c = (ecl_digit) (w >> DIGIT_BITS);
+    for (j = 1; j < NB_LIMBS; j++) {
+      w = (ecl_word) m * F::k_.p[j] + t[j] + c;
+      t[j - 1] = (ecl_digit) w;
+      c = (ecl_digit) (w >> DIGIT_BITS);
+    }
+    if (F::k_.no_carry) {
+      t[NB_LIMBS - 1] = hi + c;
+    } else {
+      w = (ecl_word) t[NB_LIMBS] + c;
+      t[NB_LIMBS - 1] = (ecl_digit) w;
+      t[NB_LIMBS] = t[NB_LIMBS + 1] + (ecl_digit) (w >> DIGIT_BITS);
+    }
+  }
+  static_gfp_final_sub<Params>(res, t, F::k_.no_carry ? 0 : t[NB_LIMBS]);
+}
+
+template<class Params>
+inline void StaticGFp<Params>::mul(Element *res, const Element &a,
+                                   const Element &b) {
+#if defined(ARCH_X86_64)
+  if (use_mulx_) {
+    static_gfp_mulx_montmul(res->val, a.val, b.val, k_.p, k_.m);
+    return;
+  }
+#endif
+  static_gfp_montmul<Params>(res->val, a.val, b.val);
+}
+
+template<class Params>
+inline void StaticGFp<Params>::sqr(Element *res, const Element &a) {
+#if defined(ARCH_X86_64)
+  if (use_mulx_) {
+    static_gfp_mulx_sqr(res->val, a.val, k_.p, k_.m);
+    return;
+  }
+#endif
+  static_gfp_montmul<Params>(res->val, a.val, a.val);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_FIELD_STATICGFP_H_
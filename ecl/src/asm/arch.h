@@ -1,5 +1,6 @@
 #if defined(ARCH_X86_64)
 #include "asm_ia64.h"
+#include "asm_ia64_mulx.h"
 #elif defined(ARCH_X86_32)
 #include "asm_ia32.h"
 #else
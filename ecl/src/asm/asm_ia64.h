@@ -33,7 +33,7 @@ __asm__ __volatile__ (                               \
 "addq  %2, %%rax     \n\t"                           \
 "movq  %%rax, %0    \n\t"                            \
 :"=g"(res)                                           \
-:"g"(a), "g"(b)                                      \
+:"rme"((ecl_digit)(a)), "rme"((ecl_digit)(b))                                    \
 :"%rax","%rdx","%cc") ;
 
 #define ADDC(res, a, b) \
@@ -42,7 +42,7 @@ __asm__ __volatile__ (                               \
 "adcq  %2, %%rax     \n\t"                           \
 "movq  %%rax, %0    \n\t"                            \
 :"=g"(res)                                           \
-:"g"(a), "g"(b)                                      \
+:"rme"((ecl_digit)(a)), "rme"((ecl_digit)(b))                                    \
 :"%rax","%rdx","%cc") ;
 
 #define GET_CARRY(carry) 												 \
@@ -60,7 +60,7 @@ __asm__ __volatile__ (                               \
 "subq  %2, %%rax     \n\t"                           \
 "movq  %%rax, %0    \n\t"                            \
 :"=g"(res)                                           \
-:"g"(a), "g"(b)                                      \
+:"rme"((ecl_digit)(a)), "rme"((ecl_digit)(b))                                    \
 :"%rax","%rdx","%cc") ;
 
 #define SUBB(res, a, b) \
@@ -69,7 +69,7 @@ __asm__ __volatile__ (                               \
 "sbbq  %2, %%rax     \n\t"                           \
 "movq  %%rax, %0    \n\t"                            \
 :"=g"(res)                                           \
-:"g"(a), "g"(b)                                      \
+:"rme"((ecl_digit)(a)), "rme"((ecl_digit)(b))                                    \
 :"%rax","%rdx","%cc") ;
 
 /* anything you need at the start */
@@ -103,7 +103,7 @@ do { c0 = c1; c1 = c2; c2 = 0; } while (0)
   "adcq  %%rdx,%1     \n\t"                            \
   "adcq  $0,%2        \n\t"                            \
   :"=r"(c0), "=r"(c1), "=r"(c2)                        \
-  : "0"(c0), "1"(c1), "2"(c2), "g"(i), "g"(j)          \
+  : "0"(c0), "1"(c1), "2"(c2), "rm"(i), "rm"(j)          \
   :"%rax","%rdx","%cc")
 
 #define MULADD_ALLREG(i, j) MULADD(i, j)
@@ -116,7 +116,7 @@ do { c0 = c1; c1 = c2; c2 = 0; } while (0)
   "adcq  %%rdx,%1     \n\t"                            \
   "adcq  $0,%2        \n\t"                            \
   :"=r"(c0), "=r"(c1), "=r"(c2)                        \
-  : "0"(c0), "1"(c1), "2"(c2), "g"(i)                  \
+  : "0"(c0), "1"(c1), "2"(c2), "rm"(i)                 \
   :"%rax","%rdx","%cc");
 
 #define SQRADD2(i, j)                                  \
@@ -130,7 +130,7 @@ do { c0 = c1; c1 = c2; c2 = 0; } while (0)
   "adcq  %%rdx,%1     \n\t"                            \
   "adcq  $0,%2        \n\t"                            \
   :"=r"(c0), "=r"(c1), "=r"(c2)                        \
-  : "0"(c0), "1"(c1), "2"(c2), "g"(i), "g"(j)          \
+  : "0"(c0), "1"(c1), "2"(c2), "rm"(i), "rm"(j)          \
   :"%rax","%rdx","%cc");
 
 #endif /* ASM_X64_H_ */
@@ -0,0 +1,444 @@
+/*
+ * asm_ia64_mulx.h
+ *
+ * Part of the ecl library.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef ASM_IA64_MULX_H_
+#define ASM_IA64_MULX_H_
+
+/* 4 limbs (256 bits) kernels using BMI2 / ADX instructions.
+ *
+ * mulx does not touch the flags, adcx only propagates CF and adox only
+ * propagates OF : the low and high halves of the partial products are
+ * accumulated on two independent carry chains.
+ * These kernels shall only be called if cpu_has_bmi2_adx() is true.
+ */
+
+#include "ecl/config.h"
+
+/* accumulates rdx * a[0..3] into t0..t4 on both carry chains
+ * t4 must be zero and flags cleared before */
+#define MULX_ROW(a, t0, t1, t2, t3, t4)           \
+  "mulxq  0(%[" a "]), %%rax, %%r8   \n\t"         \
+  "adcxq  %%rax, %%" t0 "            \n\t"         \
+  "adoxq  %%r8, %%" t1 "             \n\t"         \
+  "mulxq  8(%[" a "]), %%rax, %%r8   \n\t"         \
+  "adcxq  %%rax, %%" t1 "            \n\t"         \
+  "adoxq  %%r8, %%" t2 "             \n\t"         \
+  "mulxq  16(%[" a "]), %%rax, %%r8  \n\t"         \
+  "adcxq  %%rax, %%" t2 "            \n\t"         \
+  "adoxq  %%r8, %%" t3 "             \n\t"         \
+  "mulxq  24(%[" a "]), %%rax, %%r8  \n\t"         \
+  "adcxq  %%rax, %%" t3 "            \n\t"         \
+  "adoxq  %%r8, %%" t4 "             \n\t"         \
+  "movl   $0, %%eax                  \n\t"         \
+  "adcxq  %%rax, %%" t4 "            \n\t"
+
+/** Computes r = a * b (no reduction).
+ * @param[out] r 8 limbs result
+ * @param[in] a 4 limbs operand
+ * @param[in] b 4 limbs operand
+ */
+static inline void mulx_mul_4(ecl_digit *r, const ecl_digit *a,
+                              const ecl_digit *b) {
+  __asm__ __volatile__ (
+      /* row 0 : t0..t4 = r8, r9, r10, r11, r12 */
+      "movq   0(%[b]), %%rdx         \n\t"
+      "mulxq  0(%[a]), %%r8, %%r9    \n\t"
+      "mulxq  8(%[a]), %%rax, %%r10  \n\t"
+      "addq   %%rax, %%r9            \n\t"
+      "mulxq  16(%[a]), %%rax, %%r11 \n\t"
+      "adcq   %%rax, %%r10           \n\t"
+      "mulxq  24(%[a]), %%rax, %%r12 \n\t"
+      "adcq   %%rax, %%r11           \n\t"
+      "adcq   $0, %%r12              \n\t"
+      "movq   %%r8, 0(%[r])          \n\t"
+      /* row 1 */
+      "movq   8(%[b]), %%rdx         \n\t"
+      "xorl   %%r13d, %%r13d         \n\t"
+      MULX_ROW("a", "r9", "r10", "r11", "r12", "r13")
+      "movq   %%r9, 8(%[r])          \n\t"
+      /* row 2 */
+      "movq   16(%[b]), %%rdx        \n\t"
+      "xorl   %%r9d, %%r9d           \n\t"
+      MULX_ROW("a", "r10", "r11", "r12", "r13", "r9")
+      "movq   %%r10, 16(%[r])        \n\t"
+      /* row 3 */
+      "movq   24(%[b]), %%rdx        \n\t"
+      "xorl   %%r10d, %%r10d         \n\t"
+      MULX_ROW("a", "r11", "r12", "r13", "r9", "r10")
+      "movq   %%r11, 24(%[r])        \n\t"
+      "movq   %%r12, 32(%[r])        \n\t"
+      "movq   %%r13, 40(%[r])        \n\t"
+      "movq   %%r9, 48(%[r])         \n\t"
+      "movq   %%r10, 56(%[r])        \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a), [b] "r"(b)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "cc",
+        "memory");
+}
+
+/** Computes r = a * a (no reduction).
+ * Cross products are computed once and doubled on the CF chain while the
+ * squares are added on the OF chain.
+ * @param[out] r 8 limbs result
+ * @param[in] a 4 limbs operand
+ */
+static inline void mulx_sqr_4(ecl_digit *r, const ecl_digit *a) {
+  __asm__ __volatile__ (
+      /* cross products a0.a1, a0.a2, a0.a3 : t1..t4 = r9..r12 */
+      "movq   0(%[a]), %%rdx         \n\t"
+      "mulxq  8(%[a]), %%r9, %%r10   \n\t"
+      "mulxq  16(%[a]), %%rax, %%r11 \n\t"
+      "addq   %%rax, %%r10           \n\t"
+      "mulxq  24(%[a]), %%rax, %%r12 \n\t"
+      "adcq   %%rax, %%r11           \n\t"
+      "adcq   $0, %%r12              \n\t"
+      /* cross products a1.a2, a1.a3 : t5 = r13 */
+      "movq   8(%[a]), %%rdx         \n\t"
+      "xorl   %%r13d, %%r13d         \n\t"
+      "mulxq  16(%[a]), %%rax, %%r8  \n\t"
+      "adcxq  %%rax, %%r11           \n\t"
+      "adoxq  %%r8, %%r12            \n\t"
+      "mulxq  24(%[a]), %%rax, %%r8  \n\t"
+      "adcxq  %%rax, %%r12           \n\t"
+      "adoxq  %%r8, %%r13            \n\t"
+      "movl   $0, %%eax              \n\t"
+      "adcxq  %%rax, %%r13           \n\t"
+      /* cross product a2.a3 : t6 = r14 */
+      "movq   16(%[a]), %%rdx        \n\t"
+      "mulxq  24(%[a]), %%rax, %%r14 \n\t"
+      "addq   %%rax, %%r13           \n\t"
+      "adcq   $0, %%r14              \n\t"
+      /* double cross products (CF) and add squares (OF) : t7 = r15 */
+      "xorl   %%r15d, %%r15d         \n\t"
+      "movq   0(%[a]), %%rdx         \n\t"
+      "mulxq  %%rdx, %%rax, %%r8     \n\t"
+      "movq   %%rax, 0(%[r])         \n\t"
+      "adcxq  %%r9, %%r9             \n\t"
+      "adoxq  %%r8, %%r9             \n\t"
+      "movq   %%r9, 8(%[r])          \n\t"
+      "movq   8(%[a]), %%rdx         \n\t"
+      "mulxq  %%rdx, %%rax, %%r8     \n\t"
+      "adcxq  %%r10, %%r10           \n\t"
+      "adoxq  %%rax, %%r10           \n\t"
+      "movq   %%r10, 16(%[r])        \n\t"
+      "adcxq  %%r11, %%r11           \n\t"
+      "adoxq  %%r8, %%r11            \n\t"
+      "movq   %%r11, 24(%[r])        \n\t"
+      "movq   16(%[a]), %%rdx        \n\t"
+      "mulxq  %%rdx, %%rax, %%r8     \n\t"
+      "adcxq  %%r12, %%r12           \n\t"
+      "adoxq  %%rax, %%r12           \n\t"
+      "movq   %%r12, 32(%[r])        \n\t"
+      "adcxq  %%r13, %%r13           \n\t"
+      "adoxq  %%r8, %%r13            \n\t"
+      "movq   %%r13, 40(%[r])        \n\t"
+      "movq   24(%[a]), %%rdx        \n\t"
+      "mulxq  %%rdx, %%rax, %%r8     \n\t"
+      "adcxq  %%r14, %%r14           \n\t"
+      "adoxq  %%rax, %%r14           \n\t"
+      "movq   %%r14, 48(%[r])        \n\t"
+      "adcxq  %%r15, %%r15           \n\t"
+      "adoxq  %%r8, %%r15            \n\t"
+      "movq   %%r15, 56(%[r])        \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14",
+        "%r15", "cc", "memory");
+}
+
+/* one Montgomery reduction step : t0 is cleared, u.p is accumulated
+ * into t0..t4. t4 is cleared first */
+#define MULX_REDC_ROW(t0, t1, t2, t3, t4)         \
+  "movq   %%" t0 ", %%rdx            \n\t"         \
+  "imulq  %[m], %%rdx                \n\t"         \
+  "xorl   %%" t4 "d, %%" t4 "d       \n\t"         \
+  MULX_ROW("p", t0, t1, t2, t3, t4)
+
+/** Computes the Montgomery reduction r = a / R mod p.
+ * a shall be lower than p*R.
+ * @param[out] r 4 limbs result
+ * @param[in] a 8 limbs operand
+ * @param[in] p 4 limbs modulus
+ * @param[in] m -1/p mod 2^64
+ */
+static inline void mulx_reduce_4(ecl_digit *r, const ecl_digit *a,
+                                 const ecl_digit *p, ecl_digit m) {
+  __asm__ __volatile__ (
+      "movq   0(%[a]), %%r9          \n\t"
+      "movq   8(%[a]), %%r10         \n\t"
+      "movq   16(%[a]), %%r11        \n\t"
+      "movq   24(%[a]), %%r12        \n\t"
+      MULX_REDC_ROW("r9", "r10", "r11", "r12", "r13")
+      MULX_REDC_ROW("r10", "r11", "r12", "r13", "r14")
+      MULX_REDC_ROW("r11", "r12", "r13", "r14", "r15")
+      MULX_REDC_ROW("r12", "r13", "r14", "r15", "r9")
+      /* add upper half of a */
+      "xorl   %%eax, %%eax           \n\t"
+      "addq   32(%[a]), %%r13        \n\t"
+      "adcq   40(%[a]), %%r14        \n\t"
+      "adcq   48(%[a]), %%r15        \n\t"
+      "adcq   56(%[a]), %%r9         \n\t"
+      "adcq   $0, %%rax              \n\t"
+      /* conditional final substraction */
+      "movq   %%r13, %%r10           \n\t"
+      "subq   0(%[p]), %%r10         \n\t"
+      "movq   %%r14, %%r11           \n\t"
+      "sbbq   8(%[p]), %%r11         \n\t"
+      "movq   %%r15, %%r12           \n\t"
+      "sbbq   16(%[p]), %%r12        \n\t"
+      "movq   %%r9, %%r8             \n\t"
+      "sbbq   24(%[p]), %%r8         \n\t"
+      "sbbq   $0, %%rax              \n\t"
+      "cmovcq %%r13, %%r10           \n\t"
+      "cmovcq %%r14, %%r11           \n\t"
+      "cmovcq %%r15, %%r12           \n\t"
+      "cmovcq %%r9, %%r8             \n\t"
+      "movq   %%r10, 0(%[r])         \n\t"
+      "movq   %%r11, 8(%[r])         \n\t"
+      "movq   %%r12, 16(%[r])        \n\t"
+      "movq   %%r8, 24(%[r])         \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a), [p] "r"(p), [m] "rm"(m)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14",
+        "%r15", "cc", "memory");
+}
+
+/* one CIOS step : t0..t5 += rdx * a, then t0..t5 += (t0 * m) * p.
+ * t5 is cleared first, t0 is zero on exit. r15 is used as a zero register */
+#define MULX_CIOS_ROW(b, t0, t1, t2, t3, t4, t5)    \
+  "movq   " b ", %%rdx               \n\t"         \
+  "xorl   %%" t5 "d, %%" t5 "d       \n\t"         \
+  "mulxq  0(%[a]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t0 "            \n\t"         \
+  "adoxq  %%r8, %%" t1 "             \n\t"         \
+  "mulxq  8(%[a]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t1 "            \n\t"         \
+  "adoxq  %%r8, %%" t2 "             \n\t"         \
+  "mulxq  16(%[a]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t2 "            \n\t"         \
+  "adoxq  %%r8, %%" t3 "             \n\t"         \
+  "mulxq  24(%[a]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t3 "            \n\t"         \
+  "adoxq  %%r8, %%" t4 "             \n\t"         \
+  "adcxq  %%r15, %%" t4 "            \n\t"         \
+  "adoxq  %%r15, %%" t5 "            \n\t"         \
+  "adcxq  %%r15, %%" t5 "            \n\t"         \
+  "movq   %%" t0 ", %%rdx            \n\t"         \
+  "imulq  %[m], %%rdx                \n\t"         \
+  "xorl   %%r15d, %%r15d             \n\t"         \
+  "mulxq  0(%[p]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t0 "            \n\t"         \
+  "adoxq  %%r8, %%" t1 "             \n\t"         \
+  "mulxq  8(%[p]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t1 "            \n\t"         \
+  "adoxq  %%r8, %%" t2 "             \n\t"         \
+  "mulxq  16(%[p]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t2 "            \n\t"         \
+  "adoxq  %%r8, %%" t3 "             \n\t"         \
+  "mulxq  24(%[p]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t3 "            \n\t"         \
+  "adoxq  %%r8, %%" t4 "             \n\t"         \
+  "adcxq  %%r15, %%" t4 "            \n\t"         \
+  "adoxq  %%r15, %%" t5 "            \n\t"         \
+  "adcxq  %%r15, %%" t5 "            \n\t"
+
+/** Computes the Montgomery product r = a * b / R mod p.
+ * Multiplication and reduction are interleaved (CIOS), the accumulator
+ * stays in registers and the double size product is never stored.
+ * r may alias a or b.
+ * @param[out] r 4 limbs result
+ * @param[in] a 4 limbs operand, lower than p
+ * @param[in] b 4 limbs operand, lower than p
+ * @param[in] p 4 limbs modulus
+ * @param[in] m -1/p mod 2^64
+ */
+static inline void mulx_montmul_4(ecl_digit *r, const ecl_digit *a,
+                                  const ecl_digit *b, const ecl_digit *p,
+                                  ecl_digit m) {
+  __asm__ __volatile__ (
+      "xorl   %%r9d, %%r9d           \n\t"
+      "xorl   %%r10d, %%r10d         \n\t"
+      "xorl   %%r11d, %%r11d         \n\t"
+      "xorl   %%r12d, %%r12d         \n\t"
+      "xorl   %%r13d, %%r13d         \n\t"
+      "xorl   %%r15d, %%r15d         \n\t"
+      MULX_CIOS_ROW("0(%[b])", "r9", "r10", "r11", "r12", "r13", "r14")
+      MULX_CIOS_ROW("8(%[b])", "r10", "r11", "r12", "r13", "r14", "r9")
+      MULX_CIOS_ROW("16(%[b])", "r11", "r12", "r13", "r14", "r9", "r10")
+      MULX_CIOS_ROW("24(%[b])", "r12", "r13", "r14", "r9", "r10", "r11")
+      /* result (r13, r14, r9, r10, r11) is lower than 2p :
+       * conditional final substraction */
+      "movq   %%r13, %%rax           \n\t"
+      "subq   0(%[p]), %%rax         \n\t"
+      "movq   %%r14, %%rdx           \n\t"
+      "sbbq   8(%[p]), %%rdx         \n\t"
+      "movq   %%r9, %%r8             \n\t"
+      "sbbq   16(%[p]), %%r8         \n\t"
+      "movq   %%r10, %%r15           \n\t"
+      "sbbq   24(%[p]), %%r15        \n\t"
+      "sbbq   $0, %%r11              \n\t"
+      "cmovcq %%r13, %%rax           \n\t"
+      "cmovcq %%r14, %%rdx           \n\t"
+      "cmovcq %%r9, %%r8             \n\t"
+      "cmovcq %%r10, %%r15           \n\t"
+      "movq   %%rax, 0(%[r])         \n\t"
+      "movq   %%rdx, 8(%[r])         \n\t"
+      "movq   %%r8, 16(%[r])         \n\t"
+      "movq   %%r15, 24(%[r])        \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a), [b] "r"(b), [p] "r"(p), [m] "m"(m)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14",
+        "%r15", "cc", "memory");
+}
+
+/* P-256 kernels, p = 2^256 - 2^224 + 2^192 + 2^96 - 1.
+ * m = -1/p mod 2^64 = 1 so the quotient digit u is t0 itself, and since
+ * p[0] = 2^64 - 1, p[1] = 2^32 - 1, p[2] = 0 :
+ *   t0 + u.p[0] = u.2^64, t1 + u.p[1] + u = t1 + u.2^32
+ * the reduction step is one multiplication by p[3] and shifts. */
+
+/* one P-256 reduction step : u = t0, (t0 + u.p) / 2^64 is accumulated
+ * into t1..t4 (t0 is destroyed). t4 is cleared first */
+#define MULX_P256_REDC_ROW(t0, t1, t2, t3, t4)    \
+  "movq   %%" t0 ", %%rdx            \n\t"         \
+  "xorl   %%" t4 "d, %%" t4 "d       \n\t"         \
+  "mulxq  24(%[p]), %%rax, %%r8      \n\t"         \
+  "shlq   $32, %%" t0 "              \n\t"         \
+  "shrq   $32, %%rdx                 \n\t"         \
+  "addq   %%" t0 ", %%" t1 "         \n\t"         \
+  "adcq   %%rdx, %%" t2 "            \n\t"         \
+  "adcq   %%rax, %%" t3 "            \n\t"         \
+  "adcq   %%r8, %%" t4 "             \n\t"
+
+/** Computes the Montgomery reduction r = a / R mod p for the P-256 prime.
+ * a shall be lower than p*R.
+ * @param[out] r 4 limbs result
+ * @param[in] a 8 limbs operand
+ * @param[in] p 4 limbs P-256 modulus
+ */
+static inline void mulx_p256_reduce_4(ecl_digit *r, const ecl_digit *a,
+                                      const ecl_digit *p) {
+  __asm__ __volatile__ (
+      "movq   0(%[a]), %%r9          \n\t"
+      "movq   8(%[a]), %%r10         \n\t"
+      "movq   16(%[a]), %%r11        \n\t"
+      "movq   24(%[a]), %%r12        \n\t"
+      MULX_P256_REDC_ROW("r9", "r10", "r11", "r12", "r13")
+      MULX_P256_REDC_ROW("r10", "r11", "r12", "r13", "r14")
+      MULX_P256_REDC_ROW("r11", "r12", "r13", "r14", "r15")
+      MULX_P256_REDC_ROW("r12", "r13", "r14", "r15", "r9")
+      /* add upper half of a */
+      "xorl   %%eax, %%eax           \n\t"
+      "addq   32(%[a]), %%r13        \n\t"
+      "adcq   40(%[a]), %%r14        \n\t"
+      "adcq   48(%[a]), %%r15        \n\t"
+      "adcq   56(%[a]), %%r9         \n\t"
+      "adcq   $0, %%rax              \n\t"
+      /* conditional final substraction */
+      "movq   %%r13, %%r10           \n\t"
+      "subq   0(%[p]), %%r10         \n\t"
+      "movq   %%r14, %%r11           \n\t"
+      "sbbq   8(%[p]), %%r11         \n\t"
+      "movq   %%r15, %%r12           \n\t"
+      "sbbq   16(%[p]), %%r12        \n\t"
+      "movq   %%r9, %%r8             \n\t"
+      "sbbq   24(%[p]), %%r8         \n\t"
+      "sbbq   $0, %%rax              \n\t"
+      "cmovcq %%r13, %%r10           \n\t"
+      "cmovcq %%r14, %%r11           \n\t"
+      "cmovcq %%r15, %%r12           \n\t"
+      "cmovcq %%r9, %%r8             \n\t"
+      "movq   %%r10, 0(%[r])         \n\t"
+      "movq   %%r11, 8(%[r])         \n\t"
+      "movq   %%r12, 16(%[r])        \n\t"
+      "movq   %%r8, 24(%[r])         \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a), [p] "r"(p)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14",
+        "%r15", "cc", "memory");
+}
+
+/* one P-256 CIOS step : t0..t5 += rdx * a, then t1..t5 += (t0 + t0.p) / 2^64.
+ * t5 is cleared first, t0 is destroyed. r15 is used as a zero register */
+#define MULX_P256_CIOS_ROW(b, t0, t1, t2, t3, t4, t5)  \
+  "movq   " b ", %%rdx               \n\t"         \
+  "xorl   %%" t5 "d, %%" t5 "d       \n\t"         \
+  "mulxq  0(%[a]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t0 "            \n\t"         \
+  "adoxq  %%r8, %%" t1 "             \n\t"         \
+  "mulxq  8(%[a]), %%rax, %%r8       \n\t"         \
+  "adcxq  %%rax, %%" t1 "            \n\t"         \
+  "adoxq  %%r8, %%" t2 "             \n\t"         \
+  "mulxq  16(%[a]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t2 "            \n\t"         \
+  "adoxq  %%r8, %%" t3 "             \n\t"         \
+  "mulxq  24(%[a]), %%rax, %%r8      \n\t"         \
+  "adcxq  %%rax, %%" t3 "            \n\t"         \
+  "adoxq  %%r8, %%" t4 "             \n\t"         \
+  "adcxq  %%r15, %%" t4 "            \n\t"         \
+  "adoxq  %%r15, %%" t5 "            \n\t"         \
+  "adcxq  %%r15, %%" t5 "            \n\t"         \
+  "movq   %%" t0 ", %%rdx            \n\t"         \
+  "mulxq  24(%[p]), %%rax, %%r8      \n\t"         \
+  "shlq   $32, %%" t0 "              \n\t"         \
+  "shrq   $32, %%rdx                 \n\t"         \
+  "addq   %%" t0 ", %%" t1 "         \n\t"         \
+  "adcq   %%rdx, %%" t2 "            \n\t"         \
+  "adcq   %%rax, %%" t3 "            \n\t"         \
+  "adcq   %%r8, %%" t4 "             \n\t"         \
+  "adcq   $0, %%" t5 "               \n\t"
+
+/** Computes the Montgomery product r = a * b / R mod p for the P-256 prime.
+ * Same as mulx_montmul_4 with the reduction step of MULX_P256_REDC_ROW.
+ * r may alias a or b.
+ * @param[out] r 4 limbs result
+ * @param[in] a 4 limbs operand, lower than p
+ * @param[in] b 4 limbs operand, lower than p
+ * @param[in] p 4 limbs P-256 modulus
+ */
+static inline void mulx_p256_montmul_4(ecl_digit *r, const ecl_digit *a,
+                                       const ecl_digit *b,
+                                       const ecl_digit *p) {
+  __asm__ __volatile__ (
+      "xorl   %%r9d, %%r9d           \n\t"
+      "xorl   %%r10d, %%r10d         \n\t"
+      "xorl   %%r11d, %%r11d         \n\t"
+      "xorl   %%r12d, %%r12d         \n\t"
+      "xorl   %%r13d, %%r13d         \n\t"
+      "xorl   %%r15d, %%r15d         \n\t"
+      MULX_P256_CIOS_ROW("0(%[b])", "r9", "r10", "r11", "r12", "r13", "r14")
+      MULX_P256_CIOS_ROW("8(%[b])", "r10", "r11", "r12", "r13", "r14", "r9")
+      MULX_P256_CIOS_ROW("16(%[b])", "r11", "r12", "r13", "r14", "r9", "r10")
+      MULX_P256_CIOS_ROW("24(%[b])", "r12", "r13", "r14", "r9", "r10", "r11")
+      /* result (r13, r14, r9, r10, r11) is lower than 2p :
+       * conditional final substraction */
+      "movq   %%r13, %%rax           \n\t"
+      "subq   0(%[p]), %%rax         \n\t"
+      "movq   %%r14, %%rdx           \n\t"
+      "sbbq   8(%[p]), %%rdx         \n\t"
+      "movq   %%r9, %%r8             \n\t"
+      "sbbq   16(%[p]), %%r8         \n\t"
+      "movq   %%r10, %%r15           \n\t"
+      "sbbq   24(%[p]), %%r15        \n\t"
+      "sbbq   $0, %%r11              \n\t"
+      "cmovcq %%r13, %%rax           \n\t"
+      "cmovcq %%r14, %%rdx           \n\t"
+      "cmovcq %%r9, %%r8             \n\t"
+      "cmovcq %%r10, %%r15           \n\t"
+      "movq   %%rax, 0(%[r])         \n\t"
+      "movq   %%rdx, 8(%[r])         \n\t"
+      "movq   %%r8, 16(%[r])         \n\t"
+      "movq   %%r15, 24(%[r])        \n\t"
+      :
+      : [r] "r"(r), [a] "r"(a), [b] "r"(b), [p] "r"(p)
+      : "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14",
+        "%r15", "cc", "memory");
+}
+
+#endif /* ASM_IA64_MULX_H_ */
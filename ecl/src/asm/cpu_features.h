@@ -0,0 +1,125 @@
+/*
+ * cpu_features.h
+ *
+ * Part of the ecl library.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef CPU_FEATURES_H_
+#define CPU_FEATURES_H_
+
+#include "ecl/config.h"
+
+#if defined(ARCH_X86_64) || defined(ARCH_X86_32)
+#include <cpuid.h>
+#endif
+
+/** Tells whether the running cpu provides the BMI2 (mulx) and ADX
+ * (adcx/adox) instruction set extensions.
+ * The cpuid instruction is only issued on first call, the result is cached.
+ * @return true if both extensions are available
+ */
+static inline bool cpu_has_bmi2_adx() {
+#if defined(ARCH_X86_64)
+  static int has_bmi2_adx = -1;
+  if (has_bmi2_adx < 0) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    has_bmi2_adx = 0;
+    if (__get_cpuid_max(0, NULL) >= 7) {
+      __cpuid_count(7, 0, eax, ebx, ecx, edx);
+      // ebx bit 8 : BMI2, ebx bit 19 : ADX
+      has_bmi2_adx = ((ebx >> 8) & 1) && ((ebx >> 19) & 1);
+    }
+  }
+  return has_bmi2_adx != 0;
+#else
+  return false;
+#endif
+}
+
+/** Tells whether the running cpu provides AVX2 and the operating system
+ * saves the ymm registers.
+ * The cpuid instruction is only issued on first call, the result is cached.
+ * @return true if AVX2 is usable
+ */
+static inline bool cpu_has_avx2() {
+#if defined(ARCH_X86_64)
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    has_avx2 = 0;
+    __cpuid(1, eax, ebx, ecx, edx);
+    // ecx bit 27 : OSXSAVE, the xgetbv instruction is enabled
+    if ((ecx >> 27) & 1) {
+      unsigned int xcr0_lo, xcr0_hi;
+      __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+      // xcr0 bits 1 and 2 : sse and avx states are saved
+      if ((xcr0_lo & 6) == 6 && __get_cpuid_max(0, NULL) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        // ebx bit 5 : AVX2
+        has_avx2 = (ebx >> 5) & 1;
+      }
+    }
+  }
+  return has_avx2 != 0;
+#else
+  return false;
+#endif
+}
+
+/** Tells whether the running cpu provides AVX-512F and AVX-512 IFMA
+ * (vpmadd52luq/vpmadd52huq) and the operating system saves the zmm registers.
+ * The cpuid instruction is only issued on first call, the result is cached.
+ * @return true if AVX-512 IFMA is usable
+ */
+static inline bool cpu_has_avx512ifma() {
+#if defined(ARCH_X86_64)
+  static int has_ifma = -1;
+  if (has_ifma < 0) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    has_ifma = 0;
+    __cpuid(1, eax, ebx, ecx, edx);
+    // ecx bit 27 : OSXSAVE, the xgetbv instruction is enabled
+    if ((ecx >> 27) & 1) {
+      unsigned int xcr0_lo, xcr0_hi;
+      __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+      // xcr0 bits 1, 2 and 5 to 7 : sse, avx, opmask and zmm states are saved
+      if ((xcr0_lo & 0xe6) == 0xe6 && __get_cpuid_max(0, NULL) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        // ebx bit 16 : AVX-512F, ebx bit 21 : AVX-512 IFMA
+        has_ifma = ((ebx >> 16) & 1) && ((ebx >> 21) & 1);
+      }
+    }
+  }
+  return has_ifma != 0;
+#else
+  return false;
+#endif
+}
+
+/** Tells whether the running cpu provides the SHA extensions (sha256rnds2,
+ * sha256msg1, sha256msg2).
+ * The cpuid instruction is only issued on first call, the result is cached.
+ * @return true if the SHA extensions are available
+ */
+static inline bool cpu_has_sha_ni() {
+#if defined(ARCH_X86_64)
+  static int has_sha = -1;
+  if (has_sha < 0) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    has_sha = 0;
+    if (__get_cpuid_max(0, NULL) >= 7) {
+      __cpuid_count(7, 0, eax, ebx, ecx, edx);
+      // ebx bit 29 : SHA
+      has_sha = (ebx >> 29) & 1;
+    }
+  }
+  return has_sha != 0;
+#else
+  return false;
+#endif
+}
+
+#endif /* CPU_FEATURES_H_ */
@@ -0,0 +1,109 @@
+/**
+ * @file dispatch.cpp
+ * @author Julien Kowalski
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+#include "ecl/dispatch.h"
+
+#include "dispatch.h"
+#include "cpu_features.h"
+
+namespace ecl {
+
+/** best backend of the running cpu */
+static Backend cpu_backend() {
+  if (cpu_has_avx512ifma()) {
+    return BACKEND_AVX512;
+  }
+  if (cpu_has_avx2()) {
+    return BACKEND_AVX2;
+  }
+  if (cpu_has_bmi2_adx() || cpu_has_sha_ni()) {
+    return BACKEND_BMI2;
+  }
+  return BACKEND_GENERIC;
+}
+
+/** backend requested by the ECL_BACKEND environment variable */
+static Backend env_backend() {
+  static const char *names[BACKEND_AUTO] = { "generic", "bmi2", "avx2",
+      "avx512" };
+  const char *env = getenv("ECL_BACKEND");
+  int i;
+
+  if (env != NULL) {
+    for (i = 0; i < BACKEND_AUTO; i++) {
+      if (strcmp(env, names[i]) == 0) {
+        return static_cast<Backend>(i);
+      }
+    }
+  }
+  return BACKEND_AUTO;
+}
+
+/** fills k with the kernels of backends up to b, b supported by the cpu */
+static void install(Kernels *k, Backend b) {
+  k->backend = b;
+  k->mulx = false;
+  k->montmul_8x = NULL;
+  k->montmul_4x = NULL;
+  k->sha256_compress = digest::sha256_compress_generic;
+#if defined(ARCH_X86_64)
+  if (b >= BACKEND_BMI2) {
+    k->mulx = cpu_has_bmi2_adx();
+    if (cpu_has_sha_ni()) {
+      k->sha256_compress = digest::sha256_compress_shani;
+    }
+  }
+  if (b >= BACKEND_AVX2 && cpu_has_avx2()) {
+    k->montmul_4x = field::avx2_montmul_4x;
+  }
+  if (b >= BACKEND_AVX512) {
+    k->montmul_8x = field::ifma_montmul_8x;
+  }
+#endif
+}
+
+/** table filled from cpuid and ECL_BACKEND */
+static Kernels initial_table() {
+  Kernels k;
+  Backend b;
+
+  b = env_backend();
+  if (b == BACKEND_AUTO || b > cpu_backend()) {
+    b = cpu_backend();
+  }
+  install(&k, b);
+  return k;
+}
+
+static Kernels *table() {
+  static Kernels k = initial_table();
+  return &k;
+}
+
+const Kernels *kernels() {
+  return table();
+}
+
+Backend getBackend() {
+  return table()->backend;
+}
+
+ErrCode setBackend(Backend backend) {
+  if (backend == BACKEND_AUTO) {
+    backend = cpu_backend();
+  }
+  if (backend > cpu_backend()) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+  install(table(), backend);
+  return ERR_OK;
+}
+
+}  // namespace ecl
@@ -0,0 +1,65 @@
+/*
+ * dispatch.h
+ *
+ * Part of the ecl library.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#ifndef DISPATCH_H_
+#define DISPATCH_H_
+
+#include <cstddef>
+
+#include "ecl/config.h"
+#include "ecl/dispatch.h"
+
+namespace ecl {
+
+/** Montgomery multiplication of n elements of NB_LIMBS digits stored
+ * consecutively: res[i] = a[i].b[i] / R mod p, n multiple of the kernel width.
+ */
+typedef void (*montmul_batch_fn)(ecl_digit *res, const ecl_digit *a,
+                                 const ecl_digit *b, size_t n,
+                                 const ecl_digit *p);
+
+/** SHA-256 compression of n consecutive 64 bytes blocks into the state H */
+typedef void (*sha256_compress_fn)(uint32_t H[8], const uint8_t *data,
+                                   size_t n);
+
+/** Kernels selected for the running cpu and backend.
+ * Optional kernels are NULL when not available.
+ */
+struct Kernels {
+  Backend backend;  //!< backend in use
+  bool mulx;  //!< whether fields use the BMI2/ADX kernels
+  montmul_batch_fn montmul_8x;  //!< eight-way batch, optional
+  montmul_batch_fn montmul_4x;  //!< four-way batch, optional
+  sha256_compress_fn sha256_compress;  //!< always set
+};
+
+/** Gets the kernel table, filled on first call.
+ * @return kernel table
+ */
+const Kernels *kernels();
+
+namespace field {
+#if defined(ARCH_X86_64)
+void avx2_montmul_4x(ecl_digit *res, const ecl_digit *a, const ecl_digit *b,
+                     size_t n, const ecl_digit *p);
+void ifma_montmul_8x(ecl_digit *res, const ecl_digit *a, const ecl_digit *b,
+                     size_t n, const ecl_digit *p);
+#endif
+}  // namespace field
+
+namespace digest {
+void sha256_compress_generic(uint32_t H[8], const uint8_t *data, size_t n);
+#if defined(ARCH_X86_64)
+void sha256_compress_shani(uint32_t H[8], const uint8_t *data, size_t n);
+#endif
+}  // namespace digest
+
+}  // namespace ecl
+
+#endif /* DISPATCH_H_ */
@@ -17,19 +17,179 @@
 #include "ecl/errcode.h"
 #include "ecl/bigint/FixedSizedInt.h"
 #include "../asm/arch.h"
+#include "../field/comba.hpp"
 
 namespace ecl {
 
-template<int nb_limbs>
-FixedSizedInt<nb_limbs>::FixedSizedInt() {
-  ZEROMEM(this->val, nb_limbs_ * sizeof(ecl_digit));
+/* Carry chains r = a + b (ADD, ADDC) and r = a - b (SUB, SUBB) on N digits,
+ * unrolled at compile time. With the assembly macros the carry flag is
+ * propagated from one digit to the next and only read at the end by
+ * GET_CARRY ; the portable macros propagate it through the carry / borrow
+ * variable. DIGIT : b is a single digit, added (subtracted) to a[0].
+ */
+template<int N, bool DIGIT, int I = 1, bool END = (I == N)>
+struct AddChain {
+  static inline void run(unsigned char &carry, ecl_digit *r,
+                         const ecl_digit *a, const ecl_digit *b) {
+    ADDC(r[I], a[I], (DIGIT ? 0 : b[I]));
+    AddChain<N, DIGIT, I + 1>::run(carry, r, a, b);
+  }
+};
+
+template<int N, bool DIGIT, int I>
+struct AddChain<N, DIGIT, I, true> {
+  static inline void run(unsigned char &, ecl_digit *, const ecl_digit *,
+                         const ecl_digit *) {
+  }
+};
+
+template<int N, bool DIGIT, int I = 1, bool END = (I == N)>
+struct SubChain {
+  static inline void run(unsigned char &borrow, ecl_digit *r,
+                         const ecl_digit *a, const ecl_digit *b) {
+    SUBB(r[I], a[I], (DIGIT ? 0 : b[I]));
+    SubChain<N, DIGIT, I + 1>::run(borrow, r, a, b);
+  }
+};
+
+template<int N, bool DIGIT, int I>
+struct SubChain<N, DIGIT, I, true> {
+  static inline void run(unsigned char &, ecl_digit *, const ecl_digit *,
+                         const ecl_digit *) {
+  }
+};
+
+template<int N>
+static inline unsigned char add_chain(ecl_digit *r, const ecl_digit *a,
+                                      const ecl_digit *b) {
+  unsigned char carry = 0;
+
+  ADD(r[0], a[0], b[0]);
+  AddChain<N, false>::run(carry, r, a, b);
+  GET_CARRY(carry);
+
+  return carry;
 }
 
-template<int nb_limbs>
-FixedSizedInt<nb_limbs>::~FixedSizedInt() {
-  ZEROMEM(this->val, nb_limbs_ * sizeof(ecl_digit));
+template<int N>
+static inline unsigned char add_chain(ecl_digit *r, const ecl_digit *a,
+                                      const ecl_digit b) {
+  unsigned char carry = 0;
+
+  ADD(r[0], a[0], b);
+  AddChain<N, true>::run(carry, r, a, NULL);
+  GET_CARRY(carry);
+
+  return carry;
+}
+
+template<int N>
+static inline unsigned char sub_chain(ecl_digit *r, const ecl_digit *a,
+                                      const ecl_digit *b) {
+  unsigned char borrow = 0;
+
+  SUB(r[0], a[0], b[0]);
+  SubChain<N, false>::run(borrow, r, a, b);
+  GET_BORROW(borrow);
+
+  return borrow;
+}
+
+template<int N>
+static inline unsigned char sub_chain(ecl_digit *r, const ecl_digit *a,
+                                      const ecl_digit b) {
+  unsigned char borrow = 0;
+
+  SUB(r[0], a[0], b);
+  SubChain<N, true>::run(borrow, r, a, NULL);
+  GET_BORROW(borrow);
+
+  return borrow;
 }
 
+/* x = b^N - x if neg is 1, x otherwise ; constant time.
+ * Returns the carry out, set only for neg = 1 and x = 0. */
+template<int N>
+static inline unsigned char cond_neg(ecl_digit *x, unsigned char neg) {
+  ecl_digit mask = 0 - (ecl_digit) neg;
+  ecl_digit c = neg, t;
+  int i;
+
+  for (i = 0; i < N; i++) {
+    t = (x[i] ^ mask) + c;
+    c = (t < c);
+    x[i] = t;
+  }
+  return (unsigned char) c;
+}
+
+/* Full width products on N digits : product scanning below 16 limbs (or
+ * for an odd number of limbs), otherwise one subtractive Karatsuba level
+ * over the N / 2 limbs product scanning :
+ *   a.b = z0 + (z0 + z2 + (a0 - a1)(b1 - b0)).B + z2.B^2
+ * with a = a0 + a1.B, b = b0 + b1.B, z0 = a0.b0 and z2 = a1.b1.
+ */
+template<int N, bool KARATSUBA = (N >= 16 && (N & 1) == 0)>
+struct WideMul {
+  static inline void mul(ecl_digit *r, const ecl_digit *a,
+                         const ecl_digit *b) {
+    field::comba::mul<N>(r, a, b);
+  }
+
+  static inline void sqr(ecl_digit *r, const ecl_digit *a) {
+    field::comba::sqr<N>(r, a);
+  }
+};
+
+template<int N>
+struct WideMul<N, true> {
+  static const int H = N / 2;
+
+  /* r = z0 + z2.B^N, adds (z0 + z2 + (-1)^neg d).B^H to r */
+  static inline void add_middle(ecl_digit *r, ecl_digit *d,
+                                unsigned char neg) {
+    ecl_digit m[N], c;
+
+    c = add_chain<N>(m, r, r + N);
+    c += cond_neg<N>(d, neg);
+    c += add_chain<N>(m, m, d);
+    c -= neg;
+    c += add_chain<N>(r + H, r + H, m);
+    add_chain<H>(r + N + H, r + N + H, c);
+  }
+
+  static inline void mul(ecl_digit *r, const ecl_digit *a,
+                         const ecl_digit *b) {
+    ecl_digit da[H], db[H], d[N];
+    unsigned char sa, sb;
+
+    /* |a0 - a1| and |b1 - b0| */
+    sa = sub_chain<H>(da, a, a + H);
+    cond_neg<H>(da, sa);
+    sb = sub_chain<H>(db, b + H, b);
+    cond_neg<H>(db, sb);
+
+    WideMul<H>::mul(r, a, b);
+    WideMul<H>::mul(r + N, a + H, b + H);
+    WideMul<H>::mul(d, da, db);
+
+    add_middle(r, d, sa ^ sb);
+  }
+
+  static inline void sqr(ecl_digit *r, const ecl_digit *a) {
+    ecl_digit da[H], d[N];
+
+    cond_neg<H>(da, sub_chain<H>(da, a, a + H));
+
+    WideMul<H>::sqr(r, a);
+    WideMul<H>::sqr(r + N, a + H);
+    WideMul<H>::sqr(d, da);
+
+    /* z0 + z2 - (a0 - a1)^2 = 2.a0.a1 */
+    add_middle(r, d, 1);
+  }
+};
+
 template<int nb_limbs>
 void FixedSizedInt<nb_limbs>::zero() {
   ZEROMEM(this->val, nb_limbs_ * sizeof(ecl_digit));
@@ -123,6 +283,45 @@ ErrCode FixedSizedInt<nb_limbs>::fromString(int *sign, const string str) {
   return ERR_OK;
 }
 
+template<int nb_limbs>
+ErrCode FixedSizedInt<nb_limbs>::toBytes(unsigned char *out, size_t len,
+                                         ByteOrder order) const {
+  ecl_digit over = 0;
+  unsigned char b;
+  size_t i;
+
+  /* i is the byte position, least significant first */
+  for (i = 0; i < len; i++) {
+    b = 0;
+    if (i < (size_t) nb_bytes_) {
+      b = (unsigned char) (val[i / DIGIT_BYTES] >> (8 * (i % DIGIT_BYTES)));
+    }
+    out[order == BYTES_LE ? i : len - 1 - i] = b;
+  }
+  for (; i < (size_t) nb_bytes_; i++) {
+    over |= val[i / DIGIT_BYTES] >> (8 * (i % DIGIT_BYTES)) & 0xff;
+  }
+  return over == 0 ? ERR_OK : ERR_INVALID_VALUE;
+}
+
+template<int nb_limbs>
+ErrCode FixedSizedInt<nb_limbs>::fromBytes(const unsigned char *in, size_t len,
+                                           ByteOrder order) {
+  unsigned char over = 0, b;
+  size_t i;
+
+  zero();
+  for (i = 0; i < len; i++) {
+    b = in[order == BYTES_LE ? i : len - 1 - i];
+    if (i < (size_t) nb_bytes_) {
+      val[i / DIGIT_BYTES] |= (ecl_digit) b << (8 * (i % DIGIT_BYTES));
+    } else {
+      over |= b;
+    }
+  }
+  return over == 0 ? ERR_OK : ERR_INVALID_VALUE;
+}
+
 template<int nb_limbs>
 int FixedSizedInt<nb_limbs>::count_bits() const {
   int limb = nb_limbs - 1;
@@ -213,92 +412,42 @@ template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::add(FixedSizedInt<nb_limbs> *res,
                                            const FixedSizedInt<nb_limbs> &a,
                                            const FixedSizedInt<nb_limbs> &b) {
-  ecl_word t;
-  register unsigned char carry = 0;
-  for (int i = 0; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[i] + (ecl_word) b.val[i] + (ecl_word) carry;
-    res->val[i] = (ecl_digit) t;
-    carry = (unsigned char) (t >> DIGIT_BITS);
-  }
-  return carry;
+  return add_chain<nb_limbs>(res->val, a.val, b.val);
 }
 
 template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::add(FixedSizedInt<nb_limbs> *res,
                                            const FixedSizedInt<nb_limbs> &a,
                                            const ecl_digit b) {
-  ecl_word t;
-  register unsigned char carry = 0;
-  t = (ecl_word) a.val[0] + b;
-  res->val[0] = (ecl_digit) t;
-  carry = (unsigned char) (t >> DIGIT_BITS);
-  for (int i = 1; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[i] + (ecl_word) carry;
-    res->val[i] = (ecl_digit) t;
-    carry = (unsigned char) (t >> DIGIT_BITS);
-  }
-  return carry;
+  return add_chain<nb_limbs>(res->val, a.val, b);
 }
 
 template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::add_msw(
     FixedSizedInt<2 * nb_limbs> *res, const FixedSizedInt<2 * nb_limbs> &a,
     const FixedSizedInt<nb_limbs> &b) {
-  ecl_word t;
-  register unsigned char carry = 0;
-  for (int i = 0; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[nb_limbs_ + i] + (ecl_word) b.val[i]
-        + (ecl_word) carry;
-    res->val[nb_limbs_ + i] = (ecl_digit) t;
-    carry = (unsigned char) (t >> DIGIT_BITS);
-  }
-  return carry;
+  return add_chain<nb_limbs>(res->val + nb_limbs, a.val + nb_limbs, b.val);
 }
 
 template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::sub(FixedSizedInt<nb_limbs> *res,
                                            const FixedSizedInt<nb_limbs> &a,
                                            const FixedSizedInt<nb_limbs> &b) {
-  ecl_word t;
-  register unsigned char borrow = 0;
-  for (int i = 0; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[i] - (ecl_word) b.val[i] - (ecl_word) borrow;
-    res->val[i] = (ecl_digit) t;
-    borrow = (unsigned char) (t >> DIGIT_BITS) & 0x01;
-  }
-  return borrow;
+  return sub_chain<nb_limbs>(res->val, a.val, b.val);
 }
 
 template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::sub(FixedSizedInt<nb_limbs> *res,
                                            const FixedSizedInt<nb_limbs> &a,
                                            const ecl_digit b) {
-  ecl_word t;
-  register unsigned char borrow = 0;
-  t = (ecl_word) a.val[0] - b;
-  res->val[0] = (ecl_digit) t;
-  borrow = (unsigned char) (t >> DIGIT_BITS) & 1;
-  for (int i = 1; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[i] - (ecl_word) borrow;
-    res->val[i] = (ecl_digit) t;
-    borrow = (unsigned char) ((t >> DIGIT_BITS) & 0x01);
-  }
-  return borrow;
+  return sub_chain<nb_limbs>(res->val, a.val, b);
 }
 
 template<int nb_limbs>
 unsigned char FixedSizedInt<nb_limbs>::sub_msw(
     FixedSizedInt<2 * nb_limbs> *res, const FixedSizedInt<2 * nb_limbs> &a,
     const FixedSizedInt<nb_limbs> &b) {
-  ecl_word t;
-  register unsigned char borrow = 0;
-  for (int i = 0; i < nb_limbs_; i++) {
-    t = (ecl_word) a.val[nb_limbs_ + i] - (ecl_word) b.val[i]
-        - (ecl_word) borrow;
-    res->val[nb_limbs_ + i] = (ecl_digit) t;
-    borrow = (unsigned char) ((t >> DIGIT_BITS) & 0x01);
-  }
-  return borrow;
+  return sub_chain<nb_limbs>(res->val + nb_limbs, a.val + nb_limbs, b.val);
 }
 
 template<int nb_limbs>
@@ -326,6 +475,107 @@ void FixedSizedInt<nb_limbs>::mul(FixedSizedInt<nb_limbs> *res,
   COMBA_FINI;
 }
 
+template<int nb_limbs>
+void FixedSizedInt<nb_limbs>::mul_wide(FixedSizedInt<2 * nb_limbs> *res,
+                                       const FixedSizedInt<nb_limbs> &a,
+                                       const FixedSizedInt<nb_limbs> &b) {
+  WideMul<nb_limbs>::mul(res->val, a.val, b.val);
+}
+
+template<int nb_limbs>
+void FixedSizedInt<nb_limbs>::sqr_wide(FixedSizedInt<2 * nb_limbs> *res,
+                                       const FixedSizedInt<nb_limbs> &a) {
+  WideMul<nb_limbs>::sqr(res->val, a.val);
+}
+
+template<int nb_limbs>
+void FixedSizedInt<nb_limbs>::barrett_setup(FixedSizedInt<2 * nb_limbs> *mu,
+                                            const FixedSizedInt<nb_limbs> &m) {
+  ecl_digit rem[nb_limbs + 1], t[nb_limbs + 1];
+  ecl_word w;
+  ecl_digit borrow;
+  int i, j;
+
+  /* schoolbook binary division of b^(2k) by m */
+  mu->zero();
+  ZEROMEM(rem, sizeof(rem));
+  for (i = 2 * nb_limbs * DIGIT_BITS; i >= 0; i--) {
+    for (j = nb_limbs; j > 0; j--) {
+      rem[j] = (rem[j] << 1) | (rem[j - 1] >> (DIGIT_BITS - 1));
+    }
+    rem[0] = (rem[0] << 1) | (i == 2 * nb_limbs * DIGIT_BITS);
+
+    borrow = 0;
+    for (j = 0; j <= nb_limbs; j++) {
+      w = (ecl_word) rem[j] - (j < nb_limbs ? m.val[j] : 0) - borrow;
+      t[j] = (ecl_digit) w;
+      borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+    }
+    if (!borrow) {
+      memcpy(rem, t, sizeof(rem));
+      mu->val[i / DIGIT_BITS] |= ((ecl_digit) 1) << (i % DIGIT_BITS);
+    }
+  }
+}
+
+template<int nb_limbs>
+void FixedSizedInt<nb_limbs>::barrett_reduce(
+    FixedSizedInt<nb_limbs> *res, const FixedSizedInt<2 * nb_limbs> &a,
+    const FixedSizedInt<nb_limbs> &m, const FixedSizedInt<2 * nb_limbs> &mu) {
+  const int k = nb_limbs;
+  ecl_digit q[2 * k + 2], r[k + 1], s[k + 1];
+  ecl_digit c, borrow, mask;
+  ecl_word w;
+  int i, j;
+
+  /* q = floor(floor(a / b^(k-1)) * mu / b^(k+1)) */
+  ZEROMEM(q, sizeof(q));
+  for (i = 0; i <= k; i++) {
+    c = 0;
+    for (j = 0; j <= k; j++) {
+      w = (ecl_word) a.val[k - 1 + i] * mu.val[j] + q[i + j] + c;
+      q[i + j] = (ecl_digit) w;
+      c = (ecl_digit) (w >> DIGIT_BITS);
+    }
+    q[i + k + 1] = c;
+  }
+
+  /* r = (a - q.m) mod b^(k+1) */
+  ZEROMEM(s, sizeof(s));
+  for (i = 0; i <= k; i++) {
+    c = 0;
+    for (j = 0; j < k && i + j <= k; j++) {
+      w = (ecl_word) q[k + 1 + i] * m.val[j] + s[i + j] + c;
+      s[i + j] = (ecl_digit) w;
+      c = (ecl_digit) (w >> DIGIT_BITS);
+    }
+    if (i + k <= k) {
+      s[i + k] += c;
+    }
+  }
+  borrow = 0;
+  for (i = 0; i <= k; i++) {
+    w = (ecl_word) a.val[i] - s[i] - borrow;
+    r[i] = (ecl_digit) w;
+    borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+  }
+
+  /* r < 3m : two conditional subtractions */
+  for (j = 0; j < 2; j++) {
+    borrow = 0;
+    for (i = 0; i <= k; i++) {
+      w = (ecl_word) r[i] - (i < k ? m.val[i] : 0) - borrow;
+      s[i] = (ecl_digit) w;
+      borrow = (ecl_digit) (w >> DIGIT_BITS) & 1;
+    }
+    mask = borrow - 1;
+    for (i = 0; i <= k; i++) {
+      r[i] = (s[i] & mask) | (r[i] & ~mask);
+    }
+  }
+  memcpy(res->val, r, sizeof(res->val));
+}
+
 } /* namespace ecl */
 
 #endif /* ECL_SRC_BIGINT_FIXEDSIZEDINT_HPP_ */
@@ -0,0 +1,13 @@
+/*
+ * @file FixedSizedInt_12.cpp
+ * @author Julien Kowalski
+ */
+
+#include "ecl/bigint/FixedSizedInt.h"
+#include "FixedSizedInt.hpp"
+
+namespace ecl {
+
+template class FixedSizedInt<12> ;
+
+} /* namespace ecl */
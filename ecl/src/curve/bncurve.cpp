@@ -10,6 +10,7 @@
 #include "ecl/errcode.h"
 
 #include "ecl/field/GFp.h"
+#include "ecl/field/Fr.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
 #include "ecl/field/Fp12.h"
@@ -123,6 +124,7 @@ ErrCode GFpBnCurve::initialize(string t, string b) {
   this->set_trace();
 
   this->field_ = new GFp(this->prime_);
+  this->scalar_field_ = new Fr(this->order_);
   this->gfp_ = this->field_;
 
   this->field_->set(&tmp, -3);
@@ -152,6 +154,7 @@ ErrCode Fp2BnCurve::initialize(string t, string b) {
   this->set_trace();
 
   this->field_ = new Fp2(this->prime_);
+  this->scalar_field_ = new Fr(this->order_);
   this->gfp_ = this->field_->getBasePrimeField();
 
   this->gfp_->set(&tmp, -3);
@@ -213,7 +216,7 @@ void BnCurve<Basefield>::hash(Point *res, unsigned char buff[32],
                               int (*f_rng)(unsigned char *, int, void *),
                               void *p_rng) {
   typename Basefield::Element w, x[3], xb[3];
-  typename Basefield::Element r[3];
+  typename Basefield::Element r[3], d[2];
   typename GFp::Element tt, t2, t3;
   int alpha, beta, i;
 
@@ -224,14 +227,18 @@ void BnCurve<Basefield>::hash(Point *res, unsigned char buff[32],
   memcpy(tt.val, buff, 32);
   buff[32 - 1] = 0;
 
-  this->field_->one(&w);
+  // d0 = 1+b+t^2, d1 = (sqrt(-3).t)^2, both inverted at once
+  this->field_->one(&(d[0]));
   this->field_->one(&(x[0]));
-  this->field_->mul(&w, w, tt);
-  this->field_->sqr(&w, w);
-  this->field_->add(&w, w, this->b_);
-  this->field_->add(&w, w, x[0]);
-  this->field_->inv(&w, w);
-  this->field_->mul(&w, w, tt);
+  this->field_->mul(&(d[0]), d[0], tt);
+  this->field_->mul(&(d[1]), d[0], sqrt_m3_);
+  this->field_->sqr(&(d[1]), d[1]);
+  this->field_->sqr(&(d[0]), d[0]);
+  this->field_->add(&(d[0]), d[0], this->b_);
+  this->field_->add(&(d[0]), d[0], x[0]);
+  this->field_->copy(&(x[2]), d[0]);
+  this->field_->inv_batch(d, d, 2, xb);  // xb is not used yet
+  this->field_->mul(&w, d[0], tt);
   this->field_->mul(&w, w, sqrt_m3_);  // w = sqrt(-3).t / (1+b+t^2)
 
   this->gfp_->set(&t3, 2);
@@ -248,8 +255,8 @@ void BnCurve<Basefield>::hash(Point *res, unsigned char buff[32],
   this->field_->opp(&(x[1]), r[0]);
   this->field_->sub(&(x[1]), x[1], x[0]);  // x2 = -1 -x1
 
-  this->field_->sqr(&(x[2]), w);
-  this->field_->inv(&(x[2]), x[2]);
+  this->field_->sqr(&(x[2]), x[2]);
+  this->field_->mul(&(x[2]), x[2], d[1]);  // 1/w^2 = (1+b+t^2)^2 / (sqrt(-3).t)^2
   this->field_->add(&(x[2]), x[2], r[0]);  // 1 + 1/w^2
 
   if (f_rng != NULL) {
@@ -25,6 +25,7 @@ namespace ecl {
 namespace curve {
 
 BNPairing::BNPairing() {
+  final_exp_ = FINAL_EXP_COMPRESSED;
   s_sz_ = 0;
   t_sign_ = 0;
   t_naf_sz_ = 0;
@@ -88,31 +89,41 @@ ErrCode BNPairing::init(string t, string b) {
 
 /*************** Miller loop part */
 
-void BNPairing::mulFp2Fp2(Fp6::Element *z, const Fp6::Element& x,
+/* z = x.(ya + yb.v), unreduced : five products summed in Fp2::Double, as in
+ * Fp6::mul(Double *, ...) */
+void BNPairing::mulFp2Fp2(Fp6::Double *z, const Fp6::Element& x,
                           const Fp2::Element& ya, const Fp2::Element& yb) {
-  Fp2::Element v0, v1, tmp;
+  Fp2::Double v0, v1;
+  Fp2::Element s0, s1;
+  Fp2::Double &z0 = (*z)[0];
+  Fp2::Double &z1 = (*z)[1];
+  Fp2::Double &z2 = (*z)[2];
 
   fp2->mul(&v0, x[0], ya);
   fp2->mul(&v1, x[1], yb);
-  fp2->add(&((*z)[0]), x[1], x[2]);
-  fp2->mul(&((*z)[0]), (*z)[0], yb);
-  fp2->sub(&((*z)[0]), (*z)[0], v1);
-  fp2->mul_xsi(&((*z)[0]), (*z)[0]);
-  fp2->add(&((*z)[0]), (*z)[0], v0);
-  fp2->add(&((*z)[1]), x[0], x[1]);
-
-  fp2->add(&tmp, ya, yb);
-  fp2->mul(&((*z)[1]), (*z)[1], tmp);
-  fp2->sub(&((*z)[1]), (*z)[1], v0);
-  fp2->sub(&((*z)[1]), (*z)[1], v1);
-  fp2->add(&((*z)[2]), x[0], x[2]);
-  fp2->mul(&((*z)[2]), (*z)[2], ya);
-  fp2->sub(&((*z)[2]), (*z)[2], v0);
-  fp2->add(&((*z)[2]), (*z)[2], v1);
+
+  fp2->add(&s0, x[1], x[2]);
+  fp2->mul(&z0, s0, yb);
+  fp2->sub(&z0, z0, v1);
+  fp2->mul_xsi(&z0, z0);
+  fp2->add(&z0, z0, v0);
+
+  fp2->add(&s0, x[0], x[1]);
+  fp2->add(&s1, ya, yb);
+  fp2->mul(&z1, s0, s1);
+  fp2->sub(&z1, z1, v0);
+  fp2->sub(&z1, z1, v1);
+
+  fp2->add(&s0, x[0], x[2]);
+  fp2->mul(&z2, s0, ya);
+  fp2->sub(&z2, z2, v0);
+  fp2->add(&z2, z2, v1);
 }
 
+/* f = f.l with l = l00 + (l10 + l11.v).w : the products are kept unreduced
+ * and each of the six coefficients of f is reduced once */
 void BNPairing::mult_L(Fp12::Element *f, const Fp12::Element lpq) {
-  Fp6::Element v0, v1;
+  Fp6::Double v0, v1, d;
   Fp6::Element t0;
   Fp6::Element &f0 = (*f)[0];
   Fp6::Element &f1 = (*f)[1];
@@ -123,44 +134,122 @@ void BNPairing::mult_L(Fp12::Element *f, const Fp12::Element lpq) {
   const Fp2::Element &l10 = l1[0];
   const Fp2::Element &l11 = l1[1];
 
-  fp6->mul(&v0, f0, l00);
+  fp2->mul(&(v0[0]), f0[0], l00);
+  fp2->mul(&(v0[1]), f0[1], l00);
+  fp2->mul(&(v0[2]), f0[2], l00);
 
   mulFp2Fp2(&v1, f1, l10, l11);
 
   fp6->add(&t0, f0, f1);
   fp2->add(&tmp, l00, l10);
-  mulFp2Fp2(&f1, t0, tmp, l11);
+  mulFp2Fp2(&d, t0, tmp, l11);
 
-  fp6->mul_vi(&f0, v1);
+  fp6->sub(&d, d, v0);
+  fp6->sub(&d, d, v1);
+  fp6->reduce(&f1, d);
 
-  fp6->add(&f0, f0, v0);
+  fp6->mul_vi(&v1, v1);
+  fp6->add(&v1, v1, v0);
+  fp6->reduce(&f0, v1);
+}
 
-  fp6->sub(&f1, f1, v0);
-  fp6->sub(&f1, f1, v1);
+/* l = la.lb for two lines l = a + (b + c.v).w : six products
+ * l = aa' + xsi.cc' + bb'.v + (bc' + b'c).v^2 + ((ab' + a'b) + (ac' + a'c).v).w
+ * so that l[1][2] is zero, see mult_LL(). l shall not alias la or lb. */
+void BNPairing::mulLines(Fp12::Element *l, const Fp12::Element &la,
+                         const Fp12::Element &lb) {
+  Fp2::Double aa, bb, cc, d;
+  Fp2::Element s0, s1;
+  const Fp2::Element &a0 = la[0][0];
+  const Fp2::Element &a1 = la[1][0];
+  const Fp2::Element &a2 = la[1][1];
+  const Fp2::Element &b0 = lb[0][0];
+  const Fp2::Element &b1 = lb[1][0];
+  const Fp2::Element &b2 = lb[1][1];
+
+  fp2->mul(&aa, a0, b0);
+  fp2->mul(&bb, a1, b1);
+  fp2->mul(&cc, a2, b2);
+
+  fp2->mul_xsi(&d, cc);
+  fp2->add(&d, d, aa);
+  fp2->reduce(&((*l)[0][0]), d);
+  fp2->reduce(&((*l)[0][1]), bb);
+
+  fp2->add(&s0, a1, a2);
+  fp2->add(&s1, b1, b2);
+  fp2->mul(&d, s0, s1);
+  fp2->sub(&d, d, bb);
+  fp2->sub(&d, d, cc);
+  fp2->reduce(&((*l)[0][2]), d);
+
+  fp2->add(&s0, a0, a1);
+  fp2->add(&s1, b0, b1);
+  fp2->mul(&d, s0, s1);
+  fp2->sub(&d, d, aa);
+  fp2->sub(&d, d, bb);
+  fp2->reduce(&((*l)[1][0]), d);
+
+  fp2->add(&s0, a0, a2);
+  fp2->add(&s1, b0, b2);
+  fp2->mul(&d, s0, s1);
+  fp2->sub(&d, d, aa);
+  fp2->sub(&d, d, cc);
+  fp2->reduce(&((*l)[1][1]), d);
+
+  fp2->zero(&((*l)[1][2]));
 }
 
-void BNPairing::doubleAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
-                                  const GFpBnCurve::Point &P,
-                                  const Fp2BnCurve::Point &Q) {
-  Fp2::Element tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp;
-  Fp2::Element Tx, Ty, Tz, zero;
-  Fp6::Element a0, a1;
+/* f = f.l for a product of two lines l = l0 + (l10 + l11.v).w, as in mult_L()
+ * but with a dense l0 */
+void BNPairing::mult_LL(Fp12::Element *f, const Fp12::Element &l) {
+  Fp6::Double v0, v1, d;
+  Fp6::Element t0, t1;
+  Fp6::Element &f0 = (*f)[0];
+  Fp6::Element &f1 = (*f)[1];
 
-  fp2->zero(&zero);
+  fp6->mul(&v0, f0, l[0]);
+
+  mulFp2Fp2(&v1, f1, l[1][0], l[1][1]);
+
+  fp6->add(&t0, f0, f1);
+  fp6->add(&t1, l[0], l[1]);
+  fp6->mul(&d, t0, t1);
 
-  fp2->sqr(&tmp0, Q.x);
-  fp2->sqr(&tmp1, Q.y);
-  fp2->sqr(&tmp2, tmp1);
+  fp6->sub(&d, d, v0);
+  fp6->sub(&d, d, v1);
+  fp6->reduce(&f1, d);
+
+  fp6->mul_vi(&v1, v1);
+  fp6->add(&v1, v1, v0);
+  fp6->reduce(&f0, v1);
+}
+
+/* T = 2Q, l = line coefficients of the tangent at Q, see evalLine() */
+void BNPairing::doubleLine(Fp2BnCurve::Point *T, Fp2::Element *l,
+                           const Fp2BnCurve::Point &Q) {
+  Fp2::Element tmp0, tmp1, tmp3, tmp4, tmp5, tmp6, tmp;
+  Fp2::Element Tx, Ty, Tz;
+  Fp2::Double d0, d1, d2, d5, d;
+
+  // the squares are kept unreduced, tmp2 = Qy^4 is never reduced
+  fp2->sqr(&d0, Q.x);
+  fp2->reduce(&tmp0, d0);
+  fp2->sqr(&d1, Q.y);
+  fp2->reduce(&tmp1, d1);
+  fp2->sqr(&d2, tmp1);
 
   fp2->add(&tmp3, tmp1, Q.x);
-  fp2->sqr(&tmp3, tmp3);
-  fp2->sub(&tmp3, tmp3, tmp0);
-  fp2->sub(&tmp3, tmp3, tmp2);
-  fp2->add(&tmp3, tmp3, tmp3);
+  fp2->sqr(&d, tmp3);
+  fp2->sub(&d, d, d0);
+  fp2->sub(&d, d, d2);
+  fp2->add(&d, d, d);
+  fp2->reduce(&tmp3, d);
 
   fp2->mul(&tmp4, tmp0, 3);
   fp2->add(&tmp6, tmp4, Q.x);
-  fp2->sqr(&tmp5, tmp4);
+  fp2->sqr(&d5, tmp4);
+  fp2->reduce(&tmp5, d5);
 
   fp2->sub(&Tx, tmp5, tmp3);
   fp2->sub(&Tx, Tx, tmp3);
@@ -170,48 +259,44 @@ void BNPairing::doubleAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
   fp2->sub(&Tz, Tz, tmp1);
   fp2->sub(&Tz, Tz, Q.z2);
 
-  fp2->sub(&Ty, tmp3, Tx);
-  fp2->mul(&Ty, Ty, tmp4);
-  fp2->mul(&tmp, tmp2, 8);
-  fp2->sub(&Ty, Ty, tmp);
+  fp2->sub(&tmp, tmp3, Tx);
+  fp2->mul(&d, tmp, tmp4);
+  fp2->mul(&d2, d2, 8);
+  fp2->sub(&d, d, d2);
+  fp2->reduce(&Ty, d);
 
   fp2->mul(&tmp3, tmp4, Q.z2);
   fp2->mul(&tmp3, tmp3, 2);
-  fp2->opp(&tmp3, tmp3);
+  fp2->opp(&(l[1]), tmp3);
 
-  fp2->mul(&tmp3, tmp3, P.x);
-
-  fp2->sqr(&tmp6, tmp6);
-  fp2->sub(&tmp6, tmp6, tmp0);
-  fp2->sub(&tmp6, tmp6, tmp5);
-  fp2->mul(&tmp, tmp1, 4);
-  fp2->sub(&tmp6, tmp6, tmp);
+  fp2->sqr(&d, tmp6);
+  fp2->sub(&d, d, d0);
+  fp2->sub(&d, d, d5);
+  fp2->mul(&d1, d1, 4);
+  fp2->sub(&d, d, d1);
+  fp2->reduce(&(l[2]), d);
 
   fp2->mul(&tmp0, Tz, Q.z2);
-  fp2->add(&tmp0, tmp0, tmp0);
-  fp2->mul(&tmp0, tmp0, P.y);
-
-  fp6->init(&a0, tmp0, zero, zero);
-  fp6->init(&a1, tmp3, tmp6, zero);
-  fp12->init(lqq, a0, a1);
+  fp2->add(&(l[0]), tmp0, tmp0);
 
   E2.init(T, Tx, Ty, Tz);
 }
 
-void BNPairing::addAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
-                               const GFpBnCurve::Point &P,
-                               const Fp2BnCurve::Point &Q,
-                               const Fp2BnCurve::Point &R) {
-  Fp2::Element t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, Qy2;
-  Fp2::Element Tx, Ty, Tz, zero, tmp;
-  Fp6::Element a0, a1;
+/* T = Q + R, l = line coefficients of the line through Q and R, see
+ * evalLine() */
+void BNPairing::addLine(Fp2BnCurve::Point *T, Fp2::Element *l,
+                        const Fp2BnCurve::Point &Q,
+                        const Fp2BnCurve::Point &R) {
+  Fp2::Element t0, t1, t2, t3, t4, t5, t6, t7, t10, Qy2;
+  Fp2::Element Tx, Ty, Tz, tmp;
+  Fp2::Double dQy2, d9, d10, d;
 
-  fp2->zero(&zero);
   fp2->mul(&t0, Q.x, R.z2);
 
   fp2->add(&t1, Q.y, R.z);
   fp2->sqr(&t1, t1);
-  fp2->sqr(&Qy2, Q.y);
+  fp2->sqr(&dQy2, Q.y);
+  fp2->reduce(&Qy2, dQy2);
   fp2->sub(&t1, t1, Qy2);
   fp2->sub(&t1, t1, R.z2);
 
@@ -228,7 +313,7 @@ void BNPairing::addAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
   fp2->sub(&t6, t1, R.y);
   fp2->sub(&t6, t6, R.y);
 
-  fp2->mul(&t9, t6, Q.x);
+  fp2->mul(&d9, t6, Q.x);
 
   fp2->mul(&t7, t4, R.x);
 
@@ -244,72 +329,95 @@ void BNPairing::addAndEvalLine(Fp2BnCurve::Point *T, Fp12::Element *lqq,
 
   fp2->add(&t10, Tz, Q.y);
 
-  fp2->sub(&t8, t7, Tx);
-  fp2->mul(&t8, t8, t6);
+  // Ty = (t7 - Tx).t6 - 2.Ry.t5 with a single reduction
+  fp2->sub(&tmp, t7, Tx);
+  fp2->mul(&d, tmp, t6);
+  fp2->mul(&d10, R.y, t5);
+  fp2->mul(&d10, d10, 2);
+  fp2->sub(&d, d, d10);
+  fp2->reduce(&Ty, d);
 
-  fp2->mul(&t0, R.y, t5);
-  fp2->mul(&t0, t0, 2);
+  // t9 = 2.t6.Qx - ((Tz + Qy)^2 - Qy^2 - Tz^2), reduced once
+  fp2->sqr(&d10, t10);
+  fp2->sub(&d10, d10, dQy2);
+  fp2->sqr(&d, Tz);
+  fp2->sub(&d10, d10, d);
 
-  fp2->sub(&Ty, t8, t0);
+  fp2->mul(&d9, d9, 2);
+  fp2->sub(&d9, d9, d10);
+  fp2->reduce(&(l[2]), d9);
 
-  fp2->sqr(&t10, t10);
-  fp2->sub(&t10, t10, Qy2);
-  fp2->sqr(&tmp, Tz);
-  fp2->sub(&t10, t10, tmp);
+  fp2->add(&(l[0]), Tz, Tz);
 
-  fp2->mul(&t9, t9, 2);
-  fp2->sub(&t9, t9, t10);
+  fp2->opp(&t6, t6);
+  fp2->add(&(l[1]), t6, t6);
 
-  fp2->mul(&t10, Tz, P.y);
-  fp2->add(&t10, t10, t10);
+  E2.init(T, Tx, Ty, Tz);
+}
 
-  fp2->opp(&t6, t6);
+/* lqq = l[0].Py + (l[1].Px + l[2].v).w, the line l evaluated at P affine */
+void BNPairing::evalLine(Fp12::Element *lqq, const Fp2::Element *l,
+                         const GFpBnCurve::Point &P) {
+  Fp2::Element c0, c1, zero;
+  Fp6::Element a0, a1;
 
-  fp2->mul(&t1, t6, P.x);
-  fp2->add(&t1, t1, t1);
+  fp2->zero(&zero);
+  fp2->mul(&c0, l[0], P.y);
+  fp2->mul(&c1, l[1], P.x);
 
-  fp6->init(&a0, t10, zero, zero);
-  fp6->init(&a1, t1, t9, zero);
+  fp6->init(&a0, c0, zero, zero);
+  fp6->init(&a1, c1, l[2], zero);
   fp12->init(lqq, a0, a1);
+}
 
-  E2.init(T, Tx, Ty, Tz);
+/* number of lines of the Miller loop : one doubling per digit of s but the
+ * first, one addition per nonzero digit and the two Frobenius additions */
+int BNPairing::nb_lines() const {
+  int i, n;
+
+  n = s_sz_ + 1;
+  for (i = s_sz_ - 2; i >= 0; i--) {
+    if (s_[i]) {
+      n++;
+    }
+  }
+  return n;
 }
 
-void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
-                           const Fp2BnCurve::Point &Q) {
-  GFpBnCurve::Point PP;
-  Fp2BnCurve::Point T;
-  Fp12::Element lpq;
-  Fp2BnCurve::Point mQ, Q1, Q2, QQ;
+void BNPairing::prepare(PreparedG2 *prepared, const Fp2BnCurve::Point &Q) {
+  Fp2BnCurve::Point T, mQ, Q1, Q2, QQ;
+  Fp2::Element *l;
+  int i, n;
+
+  n = nb_lines();
+  prepared->clear();
+  prepared->lines_ = new Fp2::Element[3 * static_cast<unsigned int>(n)];
+  prepared->nb_lines_ = n;
+  prepared->pairing_ = this;
+  l = prepared->lines_;
 
   E2.init(&T);
   E2.init(&QQ);
   E2.init(&mQ);
   E2.init(&Q1);
   E2.init(&Q2);
-  E2.init(&Q2);
 
   E2.copy(&QQ, Q);
   E2.normalize(&QQ);
-  E1.copy(&PP, P);
-  E1.normalize(&PP);
-
-  fp12->one(f);
 
   E2.copy(&T, QQ);
   E2.opp(&mQ, T);
 
-  for (int i = s_sz_ - 2; i >= 0; i--) {
-    fp12->sqr(f, *f);
-    doubleAndEvalLine(&T, &lpq, PP, T);
-    mult_L(f, lpq);
+  for (i = s_sz_ - 2; i >= 0; i--) {
+    doubleLine(&T, l, T);
+    l += 3;
     if (s_[i]) {
       if (s_[i] < 0) {
-        addAndEvalLine(&T, &lpq, PP, mQ, T);
+        addLine(&T, l, mQ, T);
       } else {
-        addAndEvalLine(&T, &lpq, PP, QQ, T);
+        addLine(&T, l, QQ, T);
       }
-      mult_L(f, lpq);
+      l += 3;
     }
   }
 
@@ -319,13 +427,11 @@ void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
 
   if (t_sign_ < 0) {
     E2.opp(&T, T);
-    fp12->conj(f, *f);
   }
 
-  addAndEvalLine(&T, &lpq, PP, Q1, T);
-  mult_L(f, lpq);
-  addAndEvalLine(&T, &lpq, PP, Q2, T);
-  mult_L(f, lpq);
+  addLine(&T, l, Q1, T);
+  l += 3;
+  addLine(&T, l, Q2, T);
 
   E2.zero(&T);
   E2.zero(&mQ);
@@ -334,6 +440,137 @@ void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
   E2.zero(&Q2);
 }
 
+/* f = f.l(P). Lines are multiplied two by two before going into f, *pending
+ * keeps the first line of a pair until the second one comes. */
+void BNPairing::accumulateLine(Fp12::Element *f, Fp12::Element *pending,
+                               bool *has_pending, const Fp2::Element *l,
+                               const GFpBnCurve::Point &P) {
+  Fp12::Element lqq, ll;
+
+  if (!*has_pending) {
+    evalLine(pending, l, P);
+    *has_pending = true;
+    return;
+  }
+  evalLine(&lqq, l, P);
+  mulLines(&ll, *pending, lqq);
+  mult_LL(f, ll);
+  *has_pending = false;
+}
+
+/* f = Miller loop of (P, Q), P normalized, with the lines prepared in Q */
+void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
+                           const PreparedG2 &Q) {
+  Fp12::Element pending;
+  bool has_pending = false;
+  const Fp2::Element *l = Q.lines_;
+  GFpBnCurve::Point PP;
+
+  E1.copy(&PP, P);
+  E1.normalize(&PP);
+
+  fp12->one(f);
+
+  for (int i = s_sz_ - 2; i >= 0; i--) {
+    fp12->sqr(f, *f);
+    accumulateLine(f, &pending, &has_pending, l, PP);
+    l += 3;
+    if (s_[i]) {
+      accumulateLine(f, &pending, &has_pending, l, PP);
+      l += 3;
+    }
+    if (has_pending) {
+      mult_L(f, pending);
+      has_pending = false;
+    }
+  }
+
+  if (t_sign_ < 0) {
+    fp12->conj(f, *f);
+  }
+
+  accumulateLine(f, &pending, &has_pending, l, PP);
+  accumulateLine(f, &pending, &has_pending, l + 3, PP);
+}
+
+/* f = prod of the Miller loops of (P[j], Q[j]), n <= PAIR_CHUNK points
+ * normalized. The lines are computed on the fly and all the pairs share the
+ * squarings of f. */
+void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point *P,
+                           const Fp2BnCurve::Point *Q, size_t n) {
+  Fp2BnCurve::Point T[PAIR_CHUNK], R;
+  Fp2::Element l[3];
+  Fp12::Element pending;
+  bool has_pending = false;
+  size_t j;
+
+  E2.init(&R);
+  for (j = 0; j < n; j++) {
+    E2.init(&(T[j]));
+    E2.copy(&(T[j]), Q[j]);
+  }
+
+  fp12->one(f);
+
+  for (int i = s_sz_ - 2; i >= 0; i--) {
+    fp12->sqr(f, *f);
+    for (j = 0; j < n; j++) {
+      doubleLine(&(T[j]), l, T[j]);
+      accumulateLine(f, &pending, &has_pending, l, P[j]);
+      if (s_[i]) {
+        if (s_[i] < 0) {
+          E2.opp(&R, Q[j]);
+          addLine(&(T[j]), l, R, T[j]);
+        } else {
+          addLine(&(T[j]), l, Q[j], T[j]);
+        }
+        accumulateLine(f, &pending, &has_pending, l, P[j]);
+      }
+    }
+    if (has_pending) {
+      mult_L(f, pending);
+      has_pending = false;
+    }
+  }
+
+  if (t_sign_ < 0) {
+    fp12->conj(f, *f);
+  }
+
+  for (j = 0; j < n; j++) {
+    if (t_sign_ < 0) {
+      E2.opp(&(T[j]), T[j]);
+    }
+    E2.frobenius(&R, Q[j], 1);
+    addLine(&(T[j]), l, R, T[j]);
+    accumulateLine(f, &pending, &has_pending, l, P[j]);
+    E2.frobenius(&R, Q[j], 2);
+    E2.opp(&R, R);
+    addLine(&(T[j]), l, R, T[j]);
+    accumulateLine(f, &pending, &has_pending, l, P[j]);
+  }
+
+  for (j = 0; j < n; j++) {
+    E2.zero(&(T[j]));
+  }
+  E2.zero(&R);
+  ZEROMEM(l, sizeof(l));
+}
+
+void BNPairing::millerLoop(Fp12::Element *f, const GFpBnCurve::Point &P,
+                           const Fp2BnCurve::Point &Q) {
+  GFpBnCurve::Point PP;
+  Fp2BnCurve::Point QQ;
+
+  E1.copy(&PP, P);
+  E1.normalize(&PP);
+  E2.init(&QQ);
+  E2.copy(&QQ, Q);
+  E2.normalize(&QQ);
+  millerLoop(f, &PP, &QQ, 1);
+  E2.zero(&QQ);
+}
+
 /*************** Exponentiation part */
 
 void BNPairing::sqr_fp4(Fp2::Element *c0, Fp2::Element *c1,
@@ -373,26 +610,175 @@ void BNPairing::sqr_cycl(Fp12::Element *res, const Fp12::Element &f) {
   fp6->add(&((*res)[1]), t1, (*res)[1]);
 }
 
-void BNPairing::exp_t(Fp12::Element *res, const Fp12::Element &f) {
-  Fp12::Element tmp, inv_f;
+/*
+ * Karabina's compressed squaring. With f = A + B.w + C.w^2 over
+ * Fp4 = Fp2[w^3], the square of a cyclotomic f has B and C depending on B and
+ * C only, see sqr_cycl() : only g1, g4 (B) and g2, g5 (C) are computed, g0 and
+ * g3 (A) of res are left unchanged.
+ *   g2.g5 = ((g2 + g5)^2 - g2^2 - g5^2) / 2
+ *   h1 = 3.xsi.(2.g2.g5) + 2.g1    h4 = 3.(g2^2 + xsi.g5^2) - 2.g4
+ *   h5 = 3.(2.g1.g4) + 2.g5        h2 = 3.(g1^2 + xsi.g4^2) - 2.g2
+ * with g0 = f[0][0], g2 = f[0][1], g4 = f[0][2], g1 = f[1][0], g3 = f[1][1],
+ * g5 = f[1][2]. Six squares and four reductions.
+ */
+void BNPairing::sqr_compressed(Fp12::Element *res, const Fp12::Element &f) {
+  Fp2::Double d0, d1, d;
+  Fp2::Element t25, s25, t14, s14, t;
+
+  fp2->sqr(&d0, f[0][1]);
+  fp2->sqr(&d1, f[1][2]);
+  fp2->add(&t, f[0][1], f[1][2]);
+  fp2->sqr(&d, t);
+  fp2->sub(&d, d, d0);
+  fp2->sub(&d, d, d1);
+  fp2->reduce(&t25, d);
+  fp2->mul_xsi(&d1, d1);
+  fp2->add(&d0, d0, d1);
+  fp2->reduce(&s25, d0);
+
+  fp2->sqr(&d0, f[1][0]);
+  fp2->sqr(&d1, f[0][2]);
+  fp2->add(&t, f[1][0], f[0][2]);
+  fp2->sqr(&d, t);
+  fp2->sub(&d, d, d0);
+  fp2->sub(&d, d, d1);
+  fp2->reduce(&t14, d);
+  fp2->mul_xsi(&d1, d1);
+  fp2->add(&d0, d0, d1);
+  fp2->reduce(&s14, d0);
+
+  // 3.x + 2.y = 2.(x + y) + x and 3.x - 2.y = 2.(x - y) + x
+  fp2->mul_xsi(&t25, t25);
+  fp2->add(&t, t25, f[1][0]);
+  fp2->add(&t, t, t);
+  fp2->add(&((*res)[1][0]), t, t25);
+
+  fp2->sub(&t, s25, f[0][2]);
+  fp2->add(&t, t, t);
+  fp2->add(&((*res)[0][2]), t, s25);
+
+  fp2->add(&t, t14, f[1][2]);
+  fp2->add(&t, t, t);
+  fp2->add(&((*res)[1][2]), t, t14);
+
+  fp2->sub(&t, s14, f[0][1]);
+  fp2->add(&t, t, t);
+  fp2->add(&((*res)[0][1]), t, s14);
+}
 
-  fp12->conj(&inv_f, f);  // f cyclotomic
-  fp12->copy(&tmp, f);
+/*
+ * Recovers g3 and g0 of n <= EXP_T_CHUNK compressed cyclotomic elements, with
+ * a single inversion :
+ *   g3 = (xsi.g5^2 + 3.g2^2 - 2.g4) / (4.g1), or 2.g2.g5 / g4 if g1 = 0
+ *   g0 = xsi.(2.g3^2 + g1.g5 - 3.g2.g4) + 1
+ * The compressed 1 is all zeros, the zero inverse gives back g3 = 0, g0 = 1.
+ */
+void BNPairing::decompress_batch(Fp12::Element *g, size_t n) {
+  Fp2::Element num[EXP_T_CHUNK], den[EXP_T_CHUNK], inv[EXP_T_CHUNK], t0, t1;
+  GFp::Element one;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    Fp12::Element &f = g[i];
+    if (fp2->isZero(f[1][0])) {
+      fp2->mul(&(num[i]), f[0][1], f[1][2]);
+      fp2->add(&(num[i]), num[i], num[i]);
+      fp2->copy(&(den[i]), f[0][2]);
+    } else {
+      fp2->sqr(&t0, f[1][2]);
+      fp2->mul_xsi(&t0, t0);
+      fp2->sqr(&t1, f[0][1]);
+      fp2->mul(&t1, t1, 3);
+      fp2->add(&t0, t0, t1);
+      fp2->add(&t1, f[0][2], f[0][2]);
+      fp2->sub(&(num[i]), t0, t1);
+      fp2->mul(&(den[i]), f[1][0], 4);
+    }
+  }
+  fp2->inv_batch(inv, den, n);
+
+  gfp->one(&one);
+  for (i = 0; i < n; i++) {
+    Fp12::Element &f = g[i];
+    fp2->mul(&(f[1][1]), num[i], inv[i]);
+    fp2->sqr(&t0, f[1][1]);
+    fp2->add(&t0, t0, t0);
+    fp2->mul(&t1, f[1][0], f[1][2]);
+    fp2->add(&t0, t0, t1);
+    fp2->mul(&t1, f[0][1], f[0][2]);
+    fp2->mul(&t1, t1, 3);
+    fp2->sub(&t0, t0, t1);
+    fp2->mul_xsi(&t0, t0);
+    fp2->add(&(f[0][0]), t0, one);
+  }
+}
 
-  for (int i = t_naf_sz_ - 2; i >= 0; i--) {
-    sqr_cycl(&tmp, tmp);
+/*
+ * f^(2^k.|t|) as the product of the f^(+-2^(k+i)) for the nonzero NAF digits
+ * of t. The f^(2^(k+i)) are obtained by compressed squarings and decompressed
+ * together, EXP_T_CHUNK at a time.
+ */
+void BNPairing::exp_t(Fp12::Element *res, const Fp12::Element &f, int k) {
+  Fp12::Element c, g[EXP_T_CHUNK];
+  int sign[EXP_T_CHUNK];
+  size_t j, n = 0;
+  bool first = true;
+  int i;
+
+  fp12->copy(&c, f);
+  for (i = 0; i < k; i++) {
+    sqr_compressed(&c, c);
+  }
+  for (i = 0; i < t_naf_sz_; i++) {
+    if (i > 0) {
+      sqr_compressed(&c, c);
+    }
     if (t_naf_[i]) {
-      if (t_naf_[i] > 0) {
-        fp12->mul(&tmp, tmp, f);
-      } else {
-        fp12->mul(&tmp, tmp, inv_f);
+      fp12->copy(&(g[n]), c);
+      sign[n] = t_naf_[i];
+      n++;
+    }
+    if (n == EXP_T_CHUNK || (n > 0 && i == t_naf_sz_ - 1)) {
+      decompress_batch(g, n);
+      // f cyclotomic : f^-1 = conj(f)
+      for (j = 0; j < n; j++) {
+        if (sign[j] < 0) {
+          fp12->conj(&(g[j]), g[j]);
+        }
+        if (first) {
+          fp12->copy(res, g[j]);
+          first = false;
+        } else {
+          fp12->mul(res, *res, g[j]);
+        }
       }
+      n = 0;
     }
   }
+}
 
-  fp12->copy(res, tmp);
+/*
+ * f^(2x) for a cyclotomic f. With FINAL_EXP_COMPRESSED the squaring is done
+ * compressed within exp_t(), otherwise it is a Granger-Scott squaring of f^x.
+ */
+void BNPairing::exp_2t(Fp12::Element *res, const Fp12::Element &f) {
+  if (final_exp_ == FINAL_EXP_COMPRESSED) {
+    exp_t(res, f, 1);
+  } else {
+    exp_t(res, f, 0);
+    sqr_cycl(res, *res);
+  }
 }
 
+/*
+ * Hard part exponent 2x.(6x^2 + 3x + 1).(p^4 - p^2 + 1)/r
+ * (Fuentes-Castaneda, Knapp, Rodriguez-Henriquez) :
+ *   a = f^(12x^3 + 6x^2 + 6x), b = a.f^(-2x)
+ *   f^((p^4 - p^2 + 1)/r) = a^(p^2).b^p.(b/f)^(p^3).a.f^(6x^2).f
+ * All inverses of the hard part are conjugates. The dense work is 3 exp_t(),
+ * one or three sqr_cycl() depending on exp_2t(), 10 multiplications and 3
+ * Frobenius maps.
+ */
 void BNPairing::finalExp(Fp12::Element *res, const Fp12::Element &f) {
   Fp12::Element ff, y0, y1, y2, y3;
 
@@ -407,16 +793,14 @@ void BNPairing::finalExp(Fp12::Element *res, const Fp12::Element &f) {
 
   /* Then the hard part : compute ff^( (p^4-p^2+1)/r) */
   /* y0 = f^2x. */
-  exp_t(&y0, ff);
-  sqr_cycl(&y0, y0);
+  exp_2t(&y0, ff);
   /* y1 = f^6x. */
   sqr_cycl(&y1, y0);
   fp12->mul(&y1, y1, y0);
   /* y2 = f^6x^2. */
-  exp_t(&y2, y1);
+  exp_t(&y2, y1, 0);
   /* y3 = f^12x^3. */
-  sqr_cycl(&y3, y2);
-  exp_t(&y3, y3);
+  exp_2t(&y3, y2);
 
   if (t_sign_ < 0) {
     fp12->conj(&y0, y0);
@@ -451,6 +835,75 @@ void BNPairing::pair(Fp12::Element *res, const GFpBnCurve::Point &P,
   finalExp(res, *res);
 }
 
+ErrCode BNPairing::pair(Fp12::Element *res, const GFpBnCurve::Point &P,
+                        const PreparedG2 &Q) {
+  if (Q.lines_ == NULL || Q.pairing_ != this || Q.nb_lines_ != nb_lines()) {
+    return ERR_INVALID_VALUE;
+  }
+  fp12->zero(res);
+  millerLoop(res, P, Q);
+  finalExp(res, *res);
+  return ERR_OK;
+}
+
+void BNPairing::multi_pair(Fp12::Element *res, const GFpBnCurve::Point *P,
+                           const Fp2BnCurve::Point *Q, size_t n) {
+  GFpBnCurve::Point PP[PAIR_CHUNK];
+  Fp2BnCurve::Point QQ[PAIR_CHUNK];
+  Fp12::Element f;
+  size_t i = 0, m;
+
+  fp12->one(res);
+  while (i < n) {
+    for (m = 0; i < n && m < PAIR_CHUNK; i++) {
+      // e(O, Q) = e(P, O) = 1
+      if (P[i].isInfinity || E1.isInfinity(P[i]) || Q[i].isInfinity
+          || E2.isInfinity(Q[i])) {
+        continue;
+      }
+      E1.copy(&(PP[m]), P[i]);
+      E2.init(&(QQ[m]));
+      E2.copy(&(QQ[m]), Q[i]);
+      m++;
+    }
+    if (m > 0) {
+      E1.normalize(PP, m);
+      E2.normalize(QQ, m);
+      millerLoop(&f, PP, QQ, m);
+      fp12->mul(res, *res, f);
+    }
+  }
+  finalExp(res, *res);
+}
+
+bool BNPairing::pairing_check(const GFpBnCurve::Point *P,
+                              const Fp2BnCurve::Point *Q, size_t n) {
+  Fp12::Element f;
+
+  multi_pair(&f, P, Q, n);
+  return fp12->isOne(f);
+}
+
+PreparedG2::PreparedG2() {
+  lines_ = NULL;
+  nb_lines_ = 0;
+  pairing_ = NULL;
+}
+
+PreparedG2::~PreparedG2() {
+  clear();
+}
+
+void PreparedG2::clear() {
+  if (lines_ != NULL) {
+    ZEROMEM(lines_, 3 * nb_lines_ * sizeof(Fp2::Element));
+    delete[] lines_;
+  }
+  lines_ = NULL;
+  nb_lines_ = 0;
+  pairing_ = NULL;
+}
+
 
 ErrCode BNPairingFactory::getParameters(BNPairing *ate,
                                         GFpBnCurve::Point *gfp_generator,
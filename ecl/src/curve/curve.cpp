@@ -10,6 +10,7 @@
 #include "ecl/errcode.h"
 
 #include "ecl/field/GFp.h"
+#include "ecl/field/Fr.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
 #include "ecl/field/Fp12.h"
@@ -52,6 +53,7 @@ FpnCurve<BaseField>::FpnCurve() {
   a_is_m3_ = false;
   a_is_0_ = false;
   field_ = NULL;
+  scalar_field_ = NULL;
 }
 
 template<class BaseField>
@@ -59,6 +61,9 @@ FpnCurve<BaseField>::~FpnCurve() {
   if (field_ != NULL) {
     delete field_;
   }
+  if (scalar_field_ != NULL) {
+    delete scalar_field_;
+  }
 }
 
 template<class BaseField>
@@ -73,6 +78,7 @@ ErrCode FpnCurve<BaseField>::initialize(const string prime, const string order,
   gfp = field_->getBasePrimeField();
 
   order_.fromString(&sign, order);
+  scalar_field_ = new Fr(order_);
 
   a_is_0_ = a_is_m3_ = false;
 
@@ -177,6 +183,85 @@ void FpnCurve<BaseField>::normalize(Point *res) {
   res->isInfinity = false;
 }
 
+/*
+ * Montgomery's trick over the z of the points, with a single inversion. The
+ * products of the z are stored in the z2 of the points, then replaced by the
+ * 1/z. Points at infinity or with z = 1 are left out of the products.
+ */
+template<class BaseField>
+void FpnCurve<BaseField>::normalize(Point *res, size_t n) {
+  typename BaseField::Element invZ[BATCH_CHUNK];
+  typename BaseField::Element invZ2[BATCH_CHUNK];
+  typename BaseField::Element invZ3[BATCH_CHUNK];
+  typename BaseField::Element t;
+  Point *pt;
+  size_t i, j, m;
+
+  if (n == 0) {
+    return;
+  }
+
+  // z2 = z[0] * ... * z[i]
+  for (i = 0; i < n; i++) {
+    if (res[i].isInfinity || field_->isZero(res[i].z)
+        || field_->isOne(res[i].z)) {
+      if (i == 0) {
+        field_->one(&(res[i].z2));
+      } else {
+        field_->copy(&(res[i].z2), res[i - 1].z2);
+      }
+    } else if (i == 0) {
+      field_->copy(&(res[i].z2), res[i].z);
+    } else {
+      field_->mul(&(res[i].z2), res[i - 1].z2, res[i].z);
+    }
+  }
+
+  // t = 1 / (z[0] * ... * z[i]), z2 = 1/z
+  field_->inv(&t, res[n - 1].z2);
+  for (i = n; i-- > 0;) {
+    if (res[i].isInfinity || field_->isZero(res[i].z)
+        || field_->isOne(res[i].z)) {
+      continue;
+    }
+    if (i == 0) {
+      field_->copy(&(res[i].z2), t);
+    } else {
+      field_->mul(&(res[i].z2), t, res[i - 1].z2);
+      field_->mul(&t, t, res[i].z);
+    }
+  }
+
+  for (j = 0; j < n; j += m) {
+    m = (n - j < BATCH_CHUNK) ? n - j : BATCH_CHUNK;
+    pt = res + j;
+    for (i = 0; i < m; i++) {
+      field_->copy(&(invZ[i]), pt[i].z2);
+    }
+    // 1/z² and 1/z³ of all points at once, see BaseField::mul_batch()
+    field_->sqr_batch(invZ2, invZ, m);
+    field_->mul_batch(invZ3, invZ2, invZ, m);
+
+    for (i = 0; i < m; i++) {
+      if (field_->isOne(pt[i].z)) {
+        field_->one(&(pt[i].z2));
+        continue;
+      }
+      if (pt[i].isInfinity || field_->isZero(pt[i].z)) {
+        setInfinity(&(pt[i]));
+        continue;
+      }
+      // x = x/z², y = y/z³
+      field_->mul(&(pt[i].x), invZ2[i], pt[i].x);
+      field_->mul(&(pt[i].y), invZ3[i], pt[i].y);
+
+      field_->one(&(pt[i].z));
+      field_->one(&(pt[i].z2));
+      pt[i].isInfinity = false;
+    }
+  }
+}
+
 template<class BaseField>
 void FpnCurve<BaseField>::copy(Point *res, const Point &P) {
   field_->copy(&(res->x), P.x);
@@ -241,8 +326,9 @@ void FpnCurve<BaseField>::add(Point *res, const Point &P, const Point &Q) {
     }
   }
 
-  field_->sub(&E, B, A);
-  field_->sub(&F, D, C);
+  // E and F, then y - AE2 only feed multiplications : lazy reduction
+  field_->sub_lazy(&E, B, A);
+  field_->sub_lazy(&F, D, C);
 
   field_->mul(&(res->z), P.z, Q.z);
   field_->mul(&(res->z), res->z, E);
@@ -257,7 +343,7 @@ void FpnCurve<BaseField>::add(Point *res, const Point &P, const Point &Q) {
   field_->sub(&(res->x), res->x, AE2);
   field_->sub(&(res->x), res->x, E3);
 
-  field_->sub(&(res->y), AE2, res->x);
+  field_->sub_lazy(&(res->y), AE2, res->x);
   field_->mul(&(res->y), res->y, F);
   field_->mul(&E3, C, E3);
   field_->sub(&(res->y), res->y, E3);
@@ -276,8 +362,8 @@ void FpnCurve<BaseField>::dbl(Point *res, const Point &P) {
   field_->mul(&A, A, 4);
 
   if (a_is_m3_) {
-    field_->add(&tmp, P.x, P.z2);
-    field_->sub(&B, P.x, P.z2);
+    field_->add_lazy(&tmp, P.x, P.z2);
+    field_->sub_lazy(&B, P.x, P.z2);
     field_->mul(&B, B, tmp);
     field_->mul(&B, B, 3);
   } else {
@@ -298,7 +384,7 @@ void FpnCurve<BaseField>::dbl(Point *res, const Point &P) {
   field_->sub(&(res->x), res->x, A);
   field_->sub(&(res->x), res->x, A);
 
-  field_->sub(&(res->y), A, res->x);
+  field_->sub_lazy(&(res->y), A, res->x);
   field_->mul(&(res->y), B, res->y);
   field_->sqr(&tmp, Y2);
   field_->mul(&tmp, tmp, 8);
@@ -309,7 +395,7 @@ template<class BaseField>
 void FpnCurve<BaseField>::mul_ML(Point *res, const Point &P,
                                  const typename GFp::Element &k) {
   int i, l;
-  Point pp[2];
+  Secret<Point> pp[2];
 
   init(&(pp[0]));
   init(&(pp[1]));
@@ -326,32 +412,31 @@ void FpnCurve<BaseField>::mul_ML(Point *res, const Point &P,
   }
 
   copy(res, pp[0]);
-
-  zero(&(pp[0]));
-  zero(&(pp[1]));
 }
 
 template<class BaseField>
 ErrCode FpnCurve<BaseField>::mul_SW(Point *res, const Point &P,
                                     const typename GFp::Element &k,
                                     int window_sz) {
-  Point *precomp;
-  Point pp;
+  // odd multiples only : precomp[j] = [2j+1]P, the used ones are wiped
+  Point precomp[1 << (MAX_WINDOW_SZ - 1)];
+  Secret<Point> pp;
   Point &Q = *res;
   int i, u, s, precomp_sz;
 
-  precomp_sz = (1 << window_sz) - 1;
-
-  precomp = new Point[precomp_sz + 1];
+  if (window_sz < 1 || window_sz > MAX_WINDOW_SZ) {
+    return ERR_INVALID_VALUE;
+  }
+  precomp_sz = 1 << (window_sz - 1);
 
   init(&pp);
   dbl(&pp, P);
-  copy(&(precomp[1]), P);
+  copy(&(precomp[0]), P);
   setInfinity(&Q);
   // precomputation of [3]P .. [2^k-1]P
-  for (int j = 3; j <= precomp_sz; j += 2) {
+  for (int j = 1; j < precomp_sz; j++) {
     init(&(precomp[j]));
-    add(&(precomp[j]), pp, precomp[j - 2]);
+    add(&(precomp[j]), pp, precomp[j - 1]);
   }
 
   i = k.count_bits() - 1;
@@ -373,12 +458,13 @@ ErrCode FpnCurve<BaseField>::mul_SW(Point *res, const Point &P,
       for (int h = i; h >= s; h--) {
         u |= (1 & k.get_bit(h)) << (h - s);
       }
-      add(&Q, Q, precomp[u]);
+      // u is odd, the window ends on a set bit
+      add(&Q, Q, precomp[u >> 1]);
       i = s - 1;
     }
   }
+  ZEROMEM(precomp, precomp_sz * sizeof(Point));
 
-  delete[] precomp;
   return ERR_OK;
 }
 
@@ -429,6 +515,7 @@ ErrCode GFpCurve::initialize(const string &prime, const string &order,
   this->field_ = new GFp(prime);
 
   this->order_.fromString(&sign, order);
+  this->scalar_field_ = new Fr(this->order_);
 
   this->a_is_0_ = this->a_is_m3_ = false;
 
@@ -460,6 +547,66 @@ ErrCode GFpCurve::compress(GFp::Element *x, int *y, const Point &P) {
   return ERR_OK;
 }
 
+/*
+ * Montgomery's trick over the z of the points, with a single inversion. The
+ * products of the z are stored in x, each x[i] is replaced by the compressed
+ * form once it is no longer needed.
+ */
+ErrCode GFpCurve::compress(GFp::Element *x, int *y, const Point *P,
+                           size_t n) {
+  GFp::Element t, invZ, u;
+  Point tmp;
+  size_t i;
+
+  if (n == 0) {
+    return ERR_OK;
+  }
+
+  // x = z[0] * ... * z[i]
+  for (i = 0; i < n; i++) {
+    if (P[i].isInfinity || this->field_->isZero(P[i].z)
+        || this->field_->isOne(P[i].z)) {
+      if (i == 0) {
+        this->field_->one(&(x[i]));
+      } else {
+        this->field_->copy(&(x[i]), x[i - 1]);
+      }
+    } else if (i == 0) {
+      this->field_->copy(&(x[i]), P[i].z);
+    } else {
+      this->field_->mul(&(x[i]), x[i - 1], P[i].z);
+    }
+  }
+
+  // t = 1 / (z[0] * ... * z[i])
+  this->field_->inv(&t, x[n - 1]);
+  for (i = n; i-- > 0;) {
+    if (P[i].isInfinity || this->field_->isZero(P[i].z)
+        || this->field_->isOne(P[i].z)) {
+      this->copy(&tmp, P[i]);
+      this->normalize(&tmp);
+      x[i].copy(tmp.x);
+      y[i] = static_cast<int>(tmp.y.val[0] & 0x01);
+      continue;
+    }
+    if (i == 0) {
+      this->field_->copy(&invZ, t);
+    } else {
+      this->field_->mul(&invZ, t, x[i - 1]);
+      this->field_->mul(&t, t, P[i].z);
+    }
+    // x = x/z², y = y/z³
+    this->field_->sqr(&u, invZ);
+    this->field_->mul(&(x[i]), u, P[i].x);
+    this->field_->mul(&u, u, invZ);
+    this->field_->mul(&u, u, P[i].y);
+    y[i] = static_cast<int>(u.val[0] & 0x01);
+  }
+  this->zero(&tmp);
+
+  return ERR_OK;
+}
+
 ErrCode GFpCurve::decompress(Point *P, const GFp::Element &x, int y) {
   ErrCode rv;
   GFp::Element t1;
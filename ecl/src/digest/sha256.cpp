@@ -7,6 +7,11 @@
 #include "ecl/digest/sha256.h"
 
 #include "../asm/arch.h"
+#include "../asm/dispatch.h"
+
+#if defined(ARCH_X86_64)
+#include <immintrin.h>
+#endif
 
 namespace ecl {
 namespace digest {
@@ -55,15 +60,21 @@ void Sha256::compress() {
 }
 
 void Sha256::compress(Buffer::const_iterator it) {
+  kernels()->sha256_compress(H, &(*it), 1);
+  message_len += 64;
+}
+
+/** compresses one block into H */
+static void sha256_block(uint32_t H[8], const uint8_t *data) {
   uint32_t S[8], W[64], t0, t1;
   int i;
 
   // Prepare the message schedule, {Wt}:
   for (i = 0; i < 16; i++) {
-    W[i] = *it++ << 24;
-    W[i] |= *it++ << 16;
-    W[i] |= *it++ << 8;
-    W[i] |= *it++;
+    W[i] = *data++ << 24;
+    W[i] |= *data++ << 16;
+    W[i] |= *data++ << 8;
+    W[i] |= *data++;
   }
   for (i = 16; i < 64; i++) {
     W[i] = sigma1(W[i - 2]) + W[i - 7] + sigma0(W[i - 15]) + W[i - 16];
@@ -146,10 +157,82 @@ void Sha256::compress(Buffer::const_iterator it) {
   for (i = 0; i < 8; i++) {
     H[i] += S[i];
   }
+}
 
-  message_len += 64;
+void sha256_compress_generic(uint32_t H[8], const uint8_t *data, size_t n) {
+  for (; n > 0; n--) {
+    sha256_block(H, data);
+    data += 64;
+  }
+}
+
+#if defined(ARCH_X86_64)
+static const uint32_t K256[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* SHA-NI compression.
+ * sha256rnds2 performs two rounds on the state split in ABEF and CDGH
+ * halves, sha256msg1 and sha256msg2 compute the message schedule four words
+ * at a time : W[i..i+3] from W[i-16..i-1].
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256_compress_shani(uint32_t H[8], const uint8_t *data, size_t n) {
+  const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                       0x0405060700010203ULL);
+  __m128i state0, state1, abef, cdgh, msg, tmp, w[4];
+  int i;
+
+  // H[0..7] = ABCD EFGH to ABEF CDGH
+  tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) H), 0xB1);
+  state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) (H + 4)), 0x1B);
+  state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  for (; n > 0; n--) {
+    abef = state0;
+    cdgh = state1;
+    for (i = 0; i < 4; i++) {
+      w[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *) (data + 16 * i)), bswap);
+    }
+    // rounds 4i to 4i+3, w[i & 3] holds W[4i..4i+3]
+    for (i = 0; i < 16; i++) {
+      msg = _mm_add_epi32(w[i & 3],
+                          _mm_loadu_si128((const __m128i *) (K256 + 4 * i)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      state0 = _mm_sha256rnds2_epu32(state0, state1,
+                                     _mm_shuffle_epi32(msg, 0x0E));
+      if (i < 12) {
+        // W[4i+16..4i+19]
+        tmp = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+        tmp = _mm_add_epi32(tmp,
+                            _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+        w[i & 3] = _mm_sha256msg2_epu32(tmp, w[(i + 3) & 3]);
+      }
+    }
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+    data += 64;
+  }
 
+  // ABEF CDGH back to ABCD EFGH
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  _mm_storeu_si128((__m128i *) H, _mm_blend_epi16(tmp, state1, 0xF0));
+  _mm_storeu_si128((__m128i *) (H + 4), _mm_alignr_epi8(state1, tmp, 8));
 }
+#endif
 
 void Sha256::update(const sstring &str) {
   Buffer buff(str.begin(), str.end());
@@ -157,17 +240,30 @@ void Sha256::update(const sstring &str) {
 }
 
 void Sha256::update(const Buffer &buff) {
-  // feed into internal_buff
-  Buffer::const_iterator it;
-  for (it = buff.begin(); it + 64 <= buff.end(); it += 64) {
-    compress(it);
-  }
-  if (it < buff.end()) {
-    internal_buff.insert(internal_buff.end(), it, buff.end());
-    if (internal_buff.size() > 64) {
-      compress();
+  Buffer::const_iterator it = buff.begin();
+  size_t n;
+
+  // complete the pending block first, internal_buff keeps less than 64 bytes
+  if (!internal_buff.empty()) {
+    n = 64 - internal_buff.size();
+    if (n > buff.size()) {
+      n = buff.size();
+    }
+    internal_buff.insert(internal_buff.end(), it, it + n);
+    it += n;
+    if (internal_buff.size() < 64) {
+      return;
     }
+    compress();
+  }
+  // then the whole blocks straight from buff
+  n = (buff.end() - it) / 64;
+  if (n > 0) {
+    kernels()->sha256_compress(H, &(*it), n);
+    message_len += 64 * n;
+    it += 64 * n;
   }
+  internal_buff.insert(internal_buff.end(), it, buff.end());
 }
 
 void Sha256::final(FixedSizedBuffer<32> *res) {
@@ -0,0 +1,161 @@
+/**
+ * @file StaticGFp.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_STATICGFP_HPP_
+#define ECL_SRC_FIELD_STATICGFP_HPP_
+
+#include "ecl/field/StaticGFp.h"
+#include "../asm/arch.h"
+#include "../asm/dispatch.h"
+#include "safegcd.hpp"
+
+namespace ecl {
+namespace field {
+
+template<class Params>
+StaticGFp<Params>::StaticGFp() {
+  use_mulx_ = kernels()->mulx;
+}
+
+template<class Params>
+ErrCode StaticGFp<Params>::fromString(Element *res, const string str) {
+  ErrCode rv;
+  Element r2(UNINITIALIZED);
+  int sign;
+
+  rv = res->fromString(&sign, str);
+  if (rv != ERR_OK) {
+    return rv;
+  }
+  memcpy(r2.val, k_.R2, sizeof(r2.val));
+  mul(res, *res, r2);
+
+  if (sign < 0) {
+    opp(res, *res);
+  }
+  return ERR_OK;
+}
+
+template<class Params>
+void StaticGFp<Params>::one(Element *a) {
+  memcpy(a->val, k_.R, sizeof(a->val));
+}
+
+template<class Params>
+void StaticGFp<Params>::set(Element *a, const int v) {
+  Element vv, r2(UNINITIALIZED);
+
+  memcpy(r2.val, k_.R2, sizeof(r2.val));
+  vv.set(v < 0 ? -v : v);
+  mul(a, vv, r2);
+  if (v < 0) {
+    opp(a, *a);
+  }
+}
+
+template<class Params>
+void StaticGFp<Params>::rand(Element *res,
+                             int (*f_rng)(unsigned char *, int, void *),
+                             void *p_rng) {
+  Element p(UNINITIALIZED);
+  int bits = DIGIT_BITS;
+  ecl_digit mask = (ecl_digit) -1;
+
+  memcpy(p.val, k_.p, sizeof(p.val));
+  while ((k_.p[NB_LIMBS - 1] >> (bits - 1)) == 0) {
+    bits--;
+    mask >>= 1;
+  }
+  do {
+    f_rng((unsigned char *) res->val, NB_LIMBS * sizeof(ecl_digit), p_rng);
+    res->val[NB_LIMBS - 1] &= mask;
+  } while (cmp(*res, p) != 1);
+}
+
+template<class Params>
+bool StaticGFp<Params>::isOne(const Element &a) {
+  ecl_digit d = 0;
+  int i;
+
+  for (i = 0; i < NB_LIMBS; i++) {
+    d |= a.val[i] ^ k_.R[i];
+  }
+  return d == 0;
+}
+
+template<class Params>
+int StaticGFp<Params>::cmp(const Element &a, const Element &b) {
+  int x;
+  for (x = NB_LIMBS - 1; x >= 0; x--) {
+    if (a.val[x] > b.val[x]) {
+      return -1;
+    } else if (a.val[x] < b.val[x]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template<class Params>
+void StaticGFp<Params>::exp(Element *res, const Element &a, const Element &e) {
+  Element R;
+  int i, l;
+
+  l = e.count_bits();
+  if (l == 0) {
+    one(res);
+    return;
+  }
+
+  R.copy(a);
+  for (i = l - 1; i > 0; i--) {
+    sqr(&R, R);
+    if (e.get_bit(i - 1)) {
+      mul(&R, R, a);
+    }
+  }
+  res->copy(R);
+}
+
+template<class Params>
+void StaticGFp<Params>::inv(Element *res, const Element &a) {
+#ifdef DIGIT_64
+  Element r3(UNINITIALIZED);
+  safegcd::modinfo mi;
+  safegcd::signed62 x;
+
+  memcpy(r3.val, k_.R3, sizeof(r3.val));
+  safegcd::setup(&mi, k_.p, k_.m);
+  safegcd::from_digits(&x, a.val);
+  safegcd::modinv(&x, mi);
+  safegcd::to_digits(res->val, x);
+  /* res = (aR)^-1 -> MonPro(res, R^3) = a^-1.R */
+  mul(res, *res, r3);
+#else
+  /* Fermat : a^(p-2) */
+  Element e(UNINITIALIZED);
+
+  memcpy(e.val, k_.p, sizeof(e.val));
+  FixedSizedInt<NB_LIMBS>::sub(&e, e, 2);
+  exp(res, a, e);
+#endif
+}
+
+template<class Params>
+void StaticGFp<Params>::div(Element *res, const Element &a, const Element &b) {
+  Element tmp;
+  inv(&tmp, b);
+  mul(res, tmp, a);
+}
+
+template<class Params>
+void StaticGFp<Params>::get_characteristic(Element *p) {
+  memcpy(p->val, k_.p, sizeof(p->val));
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_STATICGFP_HPP_
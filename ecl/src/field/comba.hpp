@@ -0,0 +1,226 @@
+/**
+ * @file comba.hpp
+ * @author Julien Kowalski
+ *
+ * Product scanning (Comba) kernels for any number of limbs.
+ * The columns are generated at compile time by template recursion, so each
+ * kernel is fully unrolled with constant indices.
+ * They are the portable multiplication, squaring and reduction of GFpN (for
+ * both 64 and 32 bits digits) ; a new backend only has to provide
+ * the MULADD_ALLREG, SQRADD and SQRADD2 macros of the architecture header,
+ * which accumulate into the (c0, c1, c2) triple.
+ */
+
+#ifndef ECL_SRC_FIELD_COMBA_HPP_
+#define ECL_SRC_FIELD_COMBA_HPP_
+
+#include "ecl/config.h"
+#include "../asm/arch.h"
+
+/* The column steps must be inlined into a single function so that the
+ * (c0, c1, c2) triple stays in registers, whatever the size of the caller */
+#if defined(_MSC_VER)
+#define COMBA_INLINE __forceinline
+#else
+#define COMBA_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace ecl {
+namespace field {
+namespace comba {
+
+/* (c0, c1, c2) += sum of a[i].b[K-i] for i in [I, LAST] */
+template<int K, int I, int LAST, bool END = (I > LAST)>
+struct MulColumn {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         const ecl_digit *a, const ecl_digit *b) {
+    MULADD_ALLREG(a[I], b[K - I]);
+    MulColumn<K, I + 1, LAST>::run(c0, c1, c2, a, b);
+  }
+};
+
+template<int K, int I, int LAST>
+struct MulColumn<K, I, LAST, true> {
+  static COMBA_INLINE void run(ecl_digit &, ecl_digit &, ecl_digit &,
+                         const ecl_digit *, const ecl_digit *) {
+  }
+};
+
+/* (c0, c1, c2) += 2.sum of a[i].a[K-i] for i in [I, LAST], then a[K/2]^2
+ * if K is even */
+template<int K, int I, int LAST, bool END = (I > LAST)>
+struct SqrColumn {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         const ecl_digit *a) {
+    SQRADD2(a[I], a[K - I]);
+    SqrColumn<K, I + 1, LAST>::run(c0, c1, c2, a);
+  }
+};
+
+template<int K, int I, int LAST>
+struct SqrColumn<K, I, LAST, true> {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         const ecl_digit *a) {
+    if ((K & 1) == 0) {
+      SQRADD(a[K / 2]);
+    }
+  }
+};
+
+/* columns K to 2N-2 of the product (SQR : square of a), then the carry */
+template<int N, bool SQR, int K = 0, bool END = (K == 2 * N - 1)>
+struct Columns {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         ecl_digit *r, const ecl_digit *a,
+                         const ecl_digit *b) {
+    if (SQR) {
+      SqrColumn<K, (K < N ? 0 : K - N + 1), (K + 1) / 2 - 1>::run(c0, c1, c2,
+                                                                   a);
+    } else {
+      MulColumn<K, (K < N ? 0 : K - N + 1), (K < N ? K : N - 1)>::run(c0, c1,
+                                                                       c2, a,
+                                                                       b);
+    }
+    COMBA_STORE(r[K]);
+    COMBA_FORWARD;
+    Columns<N, SQR, K + 1>::run(c0, c1, c2, r, a, b);
+  }
+};
+
+template<int N, bool SQR, int K>
+struct Columns<N, SQR, K, true> {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &, ecl_digit &,
+                         ecl_digit *r, const ecl_digit *, const ecl_digit *) {
+    COMBA_STORE(r[K]);
+  }
+};
+
+/** Computes r = a * b.
+ * @param[out] r 2N limbs result, shall not overlap a or b
+ * @param[in] a N limbs operand
+ * @param[in] b N limbs operand
+ */
+template<int N>
+static inline void mul(ecl_digit *r, const ecl_digit *a, const ecl_digit *b) {
+  ecl_digit c0, c1, c2;
+
+  COMBA_START;
+  COMBA_CLEAR;
+  Columns<N, false>::run(c0, c1, c2, r, a, b);
+  COMBA_FINI;
+}
+
+/** Computes r = a^2, each cross product is computed once.
+ * @param[out] r 2N limbs result, shall not overlap a
+ * @param[in] a N limbs operand
+ */
+template<int N>
+static inline void sqr(ecl_digit *r, const ecl_digit *a) {
+  ecl_digit c0, c1, c2;
+
+  COMBA_START;
+  COMBA_CLEAR;
+  Columns<N, true>::run(c0, c1, c2, r, a, a);
+  COMBA_FINI;
+}
+
+/* (c0, c1, c2) = (c1, c2, 0) + t */
+static COMBA_INLINE void forward_add(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                               ecl_digit t) {
+  c0 = c1 + t;
+  c1 = c2 + (c0 < t);
+  c2 = 0;
+}
+
+/* Montgomery reduction columns : for K < N the quotient digit k[K] is
+ * computed so that column K vanishes, for K >= N column K is the digit
+ * K - N of the result */
+template<int N, int K = 0, bool LOW = (K < N), bool END = (K == 2 * N - 1)>
+struct RedColumns {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         ecl_digit *r, ecl_digit *k, const ecl_digit *t,
+                         const ecl_digit *p, ecl_digit m) {
+    if (K > 0) {
+      forward_add(c0, c1, c2, t[K]);
+    }
+    MulColumn<K, 0, K - 1>::run(c0, c1, c2, k, p);
+    k[K] = c0 * m;
+    MULADD_ALLREG(k[K], p[0]);
+    RedColumns<N, K + 1>::run(c0, c1, c2, r, k, t, p, m);
+  }
+};
+
+template<int N, int K>
+struct RedColumns<N, K, false, false> {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         ecl_digit *r, ecl_digit *k, const ecl_digit *t,
+                         const ecl_digit *p, ecl_digit m) {
+    forward_add(c0, c1, c2, t[K]);
+    MulColumn<K, K - N + 1, N - 1>::run(c0, c1, c2, k, p);
+    r[K - N] = c0;
+    RedColumns<N, K + 1>::run(c0, c1, c2, r, k, t, p, m);
+  }
+};
+
+template<int N, int K>
+struct RedColumns<N, K, false, true> {
+  static COMBA_INLINE void run(ecl_digit &c0, ecl_digit &c1, ecl_digit &c2,
+                         ecl_digit *r, ecl_digit *, const ecl_digit *t,
+                         const ecl_digit *, ecl_digit) {
+    forward_add(c0, c1, c2, t[K]);
+    r[K - N] = c0;
+  }
+};
+
+/** Computes r = r - p if r >= p or carry is set, as GFp::reduce().
+ * @param[in,out] r N limbs value, lower than 2p
+ * @param[in] carry bit of weight 2^(N*DIGIT_BITS) of r
+ * @param[in] p N limbs modulus
+ */
+template<int N>
+static inline void final_sub(ecl_digit *r, ecl_digit carry,
+                             const ecl_digit *p) {
+  ecl_digit a, d, borrow = 0;
+  int i;
+
+  if (!carry) {
+    for (i = N - 1; i >= 0; i--) {
+      if (r[i] != p[i]) {
+        break;
+      }
+    }
+    if (i >= 0 && r[i] < p[i]) {
+      return;
+    }
+  }
+  for (i = 0; i < N; i++) {
+    a = r[i];
+    d = a - p[i];
+    r[i] = d - borrow;
+    borrow = (a < p[i]) | (d < borrow);
+  }
+}
+
+/** Computes the Montgomery reduction r = t / R mod p, R = 2^(N*DIGIT_BITS).
+ * @param[out] r N limbs result
+ * @param[in] t 2N limbs operand, lower than p*R
+ * @param[in] p N limbs modulus
+ * @param[in] m -1/p mod 2^DIGIT_BITS
+ */
+template<int N>
+static inline void reduce(ecl_digit *r, const ecl_digit *t, const ecl_digit *p,
+                          ecl_digit m) {
+  ecl_digit c0, c1, c2;
+  ecl_digit k[N];
+
+  c0 = t[0];
+  c1 = c2 = 0;
+  RedColumns<N>::run(c0, c1, c2, r, k, t, p, m);
+  final_sub<N>(r, c1, p);
+}
+
+}  // namespace comba
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_COMBA_HPP_
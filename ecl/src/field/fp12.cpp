@@ -0,0 +1,17 @@
+/**
+ * @file fp12.cpp
+ * @author Julien Kowalski
+ */
+
+#include "fp12_base.hpp"
+#include "fp12_mul.hpp"
+
+namespace ecl {
+namespace field {
+
+template class Fp12N<4> ;
+template class Fp12N<6> ;
+template class Fp12N<8> ;
+
+}  // namespace field
+}  // namespace ecl
@@ -0,0 +1,221 @@
+/*
+ * @file fp12_base.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_FP12_BASE_HPP_
+#define ECL_SRC_FIELD_FP12_BASE_HPP_
+
+#include <iostream>
+
+#include <cstring>
+#include <string>
+
+#include "ecl/field/GFp.h"
+#include "ecl/field/Fp2.h"
+#include "ecl/field/Fp6.h"
+#include "ecl/field/Fp12.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+Fp12N<nb_limbs>::Fp12N(string p) {
+  fp6 = new Fp6(p);
+  fp2 = fp6->getBaseField();
+  gfp = fp2->getBasePrimeField();
+  precomputeGamma();
+}
+
+template<int nb_limbs>
+Fp12N<nb_limbs>::Fp12N(const typename GFp::Element &p) {
+  fp6 = new Fp6(p);
+  fp2 = fp6->getBaseField();
+  gfp = fp2->getBasePrimeField();
+  precomputeGamma();
+}
+
+template<int nb_limbs>
+Fp12N<nb_limbs>::~Fp12N() {
+  delete fp6;
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::precomputeGamma() {  // ok verified with code from article
+  typename Fp2::Element xsi, tmp, conjugate;
+  typename GFp::Element expo, six;
+
+  gfp->set(&six, 6);
+
+  gfp->get_characteristic(&expo);
+  gfp->sub(&expo, expo, 1);
+  gfp->div(&expo, expo, six);
+
+  fp2->get_xsi(&xsi);
+
+  fp2->exp(&tmp, xsi, expo);
+  fp2->copy(&(gamma[0][0]), tmp);  // tmp[0] == 0
+
+  for (int j = 1; j < 5; j++) {
+    fp2->mul(&(gamma[0][j]), gamma[0][j - 1], gamma[0][0]);
+  }
+
+  for (int k = 0; k < 5; k++) {
+    fp2->conj(&conjugate, gamma[0][k]);
+    fp2->mul(&(gamma[1][k]), gamma[0][k], conjugate);
+    fp2->mul(&(gamma[2][k]), gamma[1][k], gamma[0][k]);
+  }
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::rand(Element *res,
+                           int (*f_rng)(unsigned char *, int, void *),
+                           void *p_rng) {
+  fp6->rand(&((*res)[1]), f_rng, p_rng);
+  fp6->rand(&((*res)[0]), f_rng, p_rng);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::zero(Element *res) {
+  fp6->zero(&((*res)[0]));
+  fp6->zero(&((*res)[1]));
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::one(Element *res) {
+  fp6->one(&((*res)[0]));
+  fp6->zero(&((*res)[1]));
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::set(Element *res, const int v) {
+  fp6->set(&((*res)[0]), v);
+  fp6->zero(&((*res)[1]));
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::copy(Element *res, const Element &a) {
+  fp6->copy(&((*res)[0]), a[0]);
+  fp6->copy(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::copy(Double *res, const Double &a) {
+  fp6->copy(&((*res)[0]), a[0]);
+  fp6->copy(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+bool Fp12N<nb_limbs>::isOne(const Element &a) {
+  return fp6->isOne(a[0]) && fp6->isZero(a[1]);
+}
+
+template<int nb_limbs>
+bool Fp12N<nb_limbs>::isZero(const Element &a) {
+  return fp6->isZero(a[0]) && fp6->isZero(a[1]);
+}
+
+// an element is an array of 12 contiguous GFp elements
+static_assert(sizeof(Fp12::Element) == 12 * sizeof(GFp::Element),
+              "Fp12 elements shall be made of twelve contiguous GFp ones");
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::toBytes(unsigned char *out, const Element &a,
+                              ByteOrder order) {
+  gfp->toBytes(out, &(a[0][0][0]), 12, order);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::toBytes(unsigned char *out, const Element *a, size_t n,
+                              ByteOrder order) {
+  gfp->toBytes(out, &(a[0][0][0][0]), 12 * n, order);
+}
+
+template<int nb_limbs>
+ErrCode Fp12N<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                   ByteOrder order) {
+  return gfp->fromBytes(&((*res)[0][0][0]), in, 12, order);
+}
+
+template<int nb_limbs>
+ErrCode Fp12N<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                   size_t n, ByteOrder order) {
+  return gfp->fromBytes(&(res[0][0][0][0]), in, 12 * n, order);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::add(Element *res, const Element &a, const Element &b) {
+  fp6->add(&((*res)[0]), a[0], b[0]);
+  fp6->add(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::add(Double *res, const Double &a, const Double &b) {
+  fp6->add(&((*res)[0]), a[0], b[0]);
+  fp6->add(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::sub(Element *res, const Element &a, const ecl_digit b) {
+  fp6->sub(&((*res)[0]), a[0], b);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::sub(Element *res, const Element &a, const Element &b) {
+  fp6->sub(&((*res)[0]), a[0], b[0]);
+  fp6->sub(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::sub(Double *res, const Double &a, const Double &b) {
+  fp6->sub(&((*res)[0]), a[0], b[0]);
+  fp6->sub(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::opp(Element *res, const Element &a) {
+  fp6->opp(&((*res)[0]), a[0]);
+  fp6->opp(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::opp(Double *res, const Double &a) {
+  fp6->opp(&((*res)[0]), a[0]);
+  fp6->opp(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::reduce(Element *res, const Double &a) {
+  fp6->reduce(&((*res)[0]), a[0]);
+  fp6->reduce(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+int Fp12N<nb_limbs>::cmp(const Element &a, const Element &b) {
+  return fp6->cmp(a[0], b[0]) | fp6->cmp(a[1], b[1]);
+}
+
+template<int nb_limbs>
+int Fp12N<nb_limbs>::cmp(const Double &a, const Double &b) {
+  return fp6->cmp(a[0], b[0]) | fp6->cmp(a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::init(Element *res, const typename Fp6::Element &a0,
+                           const typename Fp6::Element &a1) {
+  fp6->copy(&((*res)[0]), a0);
+  fp6->copy(&((*res)[1]), a1);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::conj(Element *res, const Element &a) {
+  fp6->copy(&((*res)[0]), a[0]);
+  fp6->opp(&((*res)[1]), a[1]);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_FP12_BASE_HPP_
@@ -1,25 +1,31 @@
 /*
- * @file fp12_mul.cpp
+ * @file fp12_mul.hpp
  * @author Julien Kowalski
  */
 
+#ifndef ECL_SRC_FIELD_FP12_MUL_HPP_
+#define ECL_SRC_FIELD_FP12_MUL_HPP_
+
 #include "ecl/field/GFp.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
 #include "ecl/field/Fp12.h"
+#include "inv_batch.hpp"
 
 using ecl::ErrCode;
 
 namespace ecl {
 namespace field {
 
-void Fp12::mul(Element *res, const Element &a, const Element &b) {
+template<int nb_limbs>
+void Fp12N<nb_limbs>::mul(Element *res, const Element &a, const Element &b) {
   Double d;
   mul(&d, a, b);
   reduce(res, d);
 }
 
-void Fp12::mul(Element *res, const Element &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp12N<nb_limbs>::mul(Element *res, const Element &a, const ecl_digit b) {
   fp6->mul(&((*res)[0]), a[0], b);
   fp6->mul(&((*res)[1]), a[1], b);
 }
@@ -34,9 +40,10 @@ void Fp12::mul(Element *res, const Element &a, const ecl_digit b) {
  5. return C = c0 + c1w;
  */
 
-void Fp12::mul(Double *res, const Element &a, const Element &b) {
-  Fp6::Element s0, s1;
-  Fp6::Double t1;
+template<int nb_limbs>
+void Fp12N<nb_limbs>::mul(Double *res, const Element &a, const Element &b) {
+  typename Fp6::Element s0, s1;
+  typename Fp6::Double t1;
 
   fp6->mul(&((*res)[0]), a[0], b[0]);
   fp6->mul(&t1, a[1], b[1]);
@@ -51,7 +58,8 @@ void Fp12::mul(Double *res, const Element &a, const Element &b) {
   fp6->add(&((*res)[0]), (*res)[0], t1);
 }
 
-void Fp12::mul(Double *res, const Double &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp12N<nb_limbs>::mul(Double *res, const Double &a, const ecl_digit b) {
   fp6->mul(&((*res)[0]), a[0], b);
   fp6->mul(&((*res)[1]), a[1], b);
 }
@@ -70,8 +78,9 @@ void Fp12::mul(Double *res, const Double &a, const ecl_digit b) {
  9. return C = c0 + c1w;
  */
 // uses less temp element :
-void Fp12::sqr(Element *res, const Element &a) {
-  Fp6::Element t0, t1;
+template<int nb_limbs>
+void Fp12N<nb_limbs>::sqr(Element *res, const Element &a) {
+  typename Fp6::Element t0, t1;
 
   fp6->add(&t0, a[0], a[1]);
   fp6->mul_vi(&t1, a[1]);
@@ -84,9 +93,10 @@ void Fp12::sqr(Element *res, const Element &a) {
   fp6->add(&((*res)[1]), (*res)[1], (*res)[1]);
 }
 
-void Fp12::sqr(Double *res, const Element &a) {
-  Fp6::Element t0, t1;
-  Fp6::Double d1;
+template<int nb_limbs>
+void Fp12N<nb_limbs>::sqr(Double *res, const Element &a) {
+  typename Fp6::Element t0, t1;
+  typename Fp6::Double d1;
 
   fp6->add(&t0, a[0], a[1]);
   fp6->mul_vi(&t1, a[1]);
@@ -111,9 +121,10 @@ void Fp12::sqr(Double *res, const Element &a) {
  7. return C = c0 + c1u;
  */
 
-void Fp12::inv(Element *res, const Element &a) {
-  Fp6::Element t;
-  Fp6::Double d0, d1;  // saves one redustion
+template<int nb_limbs>
+void Fp12N<nb_limbs>::inv(Element *res, const Element &a) {
+  typename Fp6::Element t;
+  typename Fp6::Double d0, d1;  // saves one redustion
 
   fp6->sqr(&d0, a[0]);
   fp6->sqr(&d1, a[1]);
@@ -128,13 +139,27 @@ void Fp12::inv(Element *res, const Element &a) {
   fp6->opp(&((*res)[1]), t);
 }
 
-void Fp12::div(Element *res, const Element &a, const Element &b) {
-  Fp12::Element tmp;
+template<int nb_limbs>
+void Fp12N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n) {
+  simultaneous_inv(this, res, a, n, res);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n,
+                                Element *scratch) {
+  simultaneous_inv(this, res, a, n, scratch);
+}
+
+template<int nb_limbs>
+void Fp12N<nb_limbs>::div(Element *res, const Element &a, const Element &b) {
+  Element tmp;
   inv(&tmp, b);
   mul(res, a, tmp);
 }
 
-void Fp12::exp(Element *res, const Element &a, const GFp::Element &e) {
+template<int nb_limbs>
+void Fp12N<nb_limbs>::exp(Element *res, const Element &a,
+                          const typename GFp::Element &e) {
   Element R;
   int i, l;
 
@@ -150,10 +175,11 @@ void Fp12::exp(Element *res, const Element &a, const GFp::Element &e) {
   copy(res, R);
 }
 
-ErrCode Fp12::frobenius(Element *res, const Element &a, int i) {
+template<int nb_limbs>
+ErrCode Fp12N<nb_limbs>::frobenius(Element *res, const Element &a, int i) {
   ErrCode rv = ERR_OK;
-  Fp6::Element g, h;
-  Fp2::Element t1, t2, t3, t4, t5, t6;
+  typename Fp6::Element g, h;
+  typename Fp2::Element t1, t2, t3, t4, t5, t6;
 
   fp6->copy(&g, a[0]);
   fp6->copy(&h, a[1]);
@@ -196,3 +222,5 @@ ErrCode Fp12::frobenius(Element *res, const Element &a, int i) {
 
 }  // namespace field
 }  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_FP12_MUL_HPP_
@@ -0,0 +1,17 @@
+/**
+ * @file fp2.cpp
+ * @author Julien Kowalski
+ */
+
+#include "fp2_base.hpp"
+#include "fp2_mul.hpp"
+
+namespace ecl {
+namespace field {
+
+template class Fp2N<4> ;
+template class Fp2N<6> ;
+template class Fp2N<8> ;
+
+}  // namespace field
+}  // namespace ecl
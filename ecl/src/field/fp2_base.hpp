@@ -0,0 +1,275 @@
+/*
+ * @file fp2_base.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_FP2_BASE_HPP_
+#define ECL_SRC_FIELD_FP2_BASE_HPP_
+
+#include <iostream>
+
+#include <cstring>
+#include <string>
+
+#include "ecl/field/GFp.h"
+#include "ecl/field/Fp2.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+Fp2N<nb_limbs>::Fp2N(string p) {
+  gfp = new GFp(p);
+  init_qnr();
+  init_xsi();
+}
+
+template<int nb_limbs>
+Fp2N<nb_limbs>::Fp2N(const typename GFp::Element &p) {
+  gfp = new GFp(p);
+  init_qnr();
+  init_xsi();
+}
+
+template<int nb_limbs>
+Fp2N<nb_limbs>::~Fp2N() {
+  delete gfp;
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::init_qnr() {
+  typename GFp::Element a;
+  int tested = 0;
+  // get quadratic non residue from GFp
+  do {
+    tested++;
+    gfp->set(&a, -tested);
+  } while (!gfp->isQNR(a));
+  gfp_qnr_ = (ecl_digit)tested;
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::init_xsi() {
+  typename GFp::Element candidate;
+
+  // c = a²+gfp_qnr_.b² nor square nor cube in gfp
+  // severall tries :
+
+  // a = 0, b = 1 ==> c = gfp_qnr_
+  gfp->set(&candidate, gfp_qnr_);
+  if (gfp->isCNR(candidate)) {
+    xsi_ = ZERO_ONE;
+    return;
+  }
+
+  // a = 1, b = 1 ==> c = gfp_qnr_ + 1
+  gfp->set(&candidate, gfp_qnr_ + 1);
+  if (gfp->isQNR(candidate) && gfp->isCNR(candidate)) {
+    xsi_ = ONE_ONE;
+    return;
+  }
+
+  // a = 2, b = 1 ==> c = gfp_qnr_ + 4
+  gfp->set(&candidate, gfp_qnr_ + 4);
+  if (gfp->isQNR(candidate) && gfp->isCNR(candidate)) {
+    xsi_ = TWO_ONE;
+    return;
+  }
+
+  // a = 3, b = 1 ==> c = gfp_qnr_ + 9
+  gfp->set(&candidate, gfp_qnr_ + 9);
+  if (gfp->isQNR(candidate) && gfp->isCNR(candidate)) {
+    xsi_ = THREE_ONE;
+    return;
+  }
+}
+
+template<int nb_limbs>
+ErrCode Fp2N<nb_limbs>::get_xsi(Element *res) {
+  switch (xsi_) {
+    case ZERO_ONE:
+      res[0]->zero();
+      gfp->one(&((*res)[1]));
+      break;
+    case ONE_ONE:
+      gfp->one(&((*res)[0]));
+      gfp->one(&((*res)[1]));
+      break;
+    case TWO_ONE:
+      gfp->set(&((*res)[0]), 2);
+      gfp->one(&((*res)[1]));
+      break;
+    case THREE_ONE:
+      gfp->set(&((*res)[0]), 3);
+      gfp->one(&((*res)[1]));
+      break;
+    default:
+      return ERR_NOT_IMPLEMENTED;
+  }
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::rand(Element *res,
+                          int (*f_rng)(unsigned char *, int, void *),
+                          void *p_rng) {
+  gfp->rand(&((*res)[1]), f_rng, p_rng);
+  gfp->rand(&((*res)[0]), f_rng, p_rng);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::zero(Element *res) {
+  (*res)[0].zero();
+  (*res)[1].zero();
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::one(Element *res) {
+  gfp->one(&((*res)[0]));
+  (*res)[1].zero();
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::set(Element *res, const int v) {
+  gfp->set(&((*res)[0]), v);
+  (*res)[1].zero();
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::copy(Element *res, const Element &a) {
+  ((*res)[0]).copy(a[0]);
+  ((*res)[1]).copy(a[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::copy(Double *res, const Double &a) {
+  ((*res)[0]).copy(a[0]);
+  ((*res)[1]).copy(a[1]);
+}
+
+template<int nb_limbs>
+bool Fp2N<nb_limbs>::isOne(const Element &a) {
+  return gfp->isOne(a[0]) && a[1].isZero();
+}
+
+template<int nb_limbs>
+bool Fp2N<nb_limbs>::isZero(const Element &a) {
+  return gfp->isZero(a[0]) && gfp->isZero(a[1]);
+}
+
+// an element is an array of 2 contiguous GFp elements
+static_assert(sizeof(Fp2::Element) == 2 * sizeof(GFp::Element),
+              "Fp2 elements shall be made of two contiguous GFp ones");
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::toBytes(unsigned char *out, const Element &a,
+                             ByteOrder order) {
+  gfp->toBytes(out, &(a[0]), 2, order);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::toBytes(unsigned char *out, const Element *a, size_t n,
+                             ByteOrder order) {
+  gfp->toBytes(out, &(a[0][0]), 2 * n, order);
+}
+
+template<int nb_limbs>
+ErrCode Fp2N<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                  ByteOrder order) {
+  return gfp->fromBytes(&((*res)[0]), in, 2, order);
+}
+
+template<int nb_limbs>
+ErrCode Fp2N<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                  size_t n, ByteOrder order) {
+  return gfp->fromBytes(&(res[0][0]), in, 2 * n, order);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::add(Element *res, const Element &a, const Element &b) {
+  gfp->add(&((*res)[0]), a[0], b[0]);
+  gfp->add(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::add(Element *res, const Element &a,
+                         const typename GFp::Element &b) {
+  gfp->add(&((*res)[0]), a[0], b);
+  ((*res)[1]).copy(a[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::add(Double *res, const Double &a, const Double &b) {
+  gfp->add(&((*res)[0]), a[0], b[0]);
+  gfp->add(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sub(Element *res, const Element &a, const ecl_digit b) {
+  gfp->sub(&((*res)[0]), a[0], b);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sub(Element *res, const Element &a, const Element &b) {
+  gfp->sub(&((*res)[0]), a[0], b[0]);
+  gfp->sub(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sub(Double *res, const Double &a, const Double &b) {
+  gfp->sub(&((*res)[0]), a[0], b[0]);
+  gfp->sub(&((*res)[1]), a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::opp(Element *res, const Element &a) {
+  gfp->opp(&((*res)[0]), a[0]);
+  gfp->opp(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::opp(Double *res, const Double &a) {
+  gfp->opp(&((*res)[0]), a[0]);
+  gfp->opp(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::reduce(Element *res, const Double &a) {
+  gfp->reduce(&((*res)[0]), a[0]);
+  gfp->reduce(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+int Fp2N<nb_limbs>::cmp(const Element &a, const Element &b) {
+  return gfp->cmp(a[0], b[0]) | gfp->cmp(a[1], b[1]);
+}
+
+template<int nb_limbs>
+int Fp2N<nb_limbs>::cmp(const Element &a, const typename GFp::Element &b) {
+  return gfp->cmp(a[0], b) | gfp->cmp(a[1], 0);
+}
+
+template<int nb_limbs>
+int Fp2N<nb_limbs>::cmp(const Double &a, const Double &b) {
+  return gfp->cmp(a[0], b[0]) | gfp->cmp(a[1], b[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::conj(Element *res, const Element &a) {
+  ((*res)[0]).copy(a[0]);
+  gfp->opp(&((*res)[1]), a[1]);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::init(Element *res, const typename GFp::Element &a0,
+                          const typename GFp::Element &a1) {
+  ((*res)[0]).copy(a0);
+  ((*res)[1]).copy(a1);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_FP2_BASE_HPP_
@@ -1,41 +1,52 @@
 /*
- * @file fp2_mul.cpp
+ * @file fp2_mul.hpp
  * @author Julien Kowalski
  */
+
+#ifndef ECL_SRC_FIELD_FP2_MUL_HPP_
+#define ECL_SRC_FIELD_FP2_MUL_HPP_
 #include "ecl/field/GFp.h"
 #include "ecl/field/Fp2.h"
+#include "inv_batch.hpp"
 
 using ecl::ErrCode;
 
 namespace ecl {
 namespace field {
 
-void Fp2::mul(Element (*res), const Element &a, const Element &b) {
+/* number of elements of mul_batch() and sqr_batch() kept on the stack */
+static const size_t BATCH_CHUNK = 16;
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul(Element (*res), const Element &a, const Element &b) {
   Double d;
   mul(&d, a, b);
   reduce(res, d);
 }
 
-void Fp2::mul(Element (*res), const Element &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul(Element (*res), const Element &a, const ecl_digit b) {
   gfp->mul(&((*res)[0]), a[0], b);
   gfp->mul(&((*res)[1]), a[1], b);
 }
 
-void Fp2::mul(Element (*res), const Element &a,
-              const GFp::Element &b) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul(Element (*res), const Element &a,
+                         const typename GFp::Element &b) {
   gfp->mul(&((*res)[0]), a[0], b);
   gfp->mul(&((*res)[1]), a[1], b);
 }
 
-void Fp2::mul(Double (*res), const Element &a, const Element &b) {
-  GFp::Double t1;
-  GFp::Element t2, t3;
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul(Double (*res), const Element &a, const Element &b) {
+  Public<typename GFp::Double> t1;
+  Public<typename GFp::Element> t2, t3;
 
   gfp->mul(&((*res)[0]), a[0], b[0]);
   gfp->mul(&t1, a[1], b[1]);
 
-  gfp->add(&t2, a[0], a[1]);
-  gfp->add(&t3, b[0], b[1]);
+  gfp->add_lazy(&t2, a[0], a[1]);
+  gfp->add_lazy(&t3, b[0], b[1]);
 
   gfp->mul(&((*res)[1]), t2, t3);
   gfp->sub(&((*res)[1]), (*res)[1], (*res)[0] );
@@ -45,16 +56,18 @@ void Fp2::mul(Double (*res), const Element &a, const Element &b) {
   gfp->sub(&((*res)[0]), (*res)[0], t1);
 }
 
-void Fp2::mul(Double (*res), const Double &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul(Double (*res), const Double &a, const ecl_digit b) {
   gfp->mul(&((*res)[0]), a[0], b);
   gfp->mul(&((*res)[1]), a[1], b);
 }
 
-void Fp2::sqr(Element (*res), const Element &a) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sqr(Element (*res), const Element &a) {
   if (gfp_qnr_ == 1) {  // less temporary elements
-    GFp::Element t0, t1, i0;
-    gfp->add(&t0, a[0], a[1]);
-    gfp->sub(&t1, a[0], a[1]);
+    Public<typename GFp::Element> t0, t1, i0;
+    gfp->add_lazy(&t0, a[0], a[1]);
+    gfp->sub_lazy(&t1, a[0], a[1]);
     gfp->mul(&i0, t0, t1);
     gfp->mul(&((*res)[1]), a[0], a[1]);
     gfp->add(&((*res)[1]), (*res)[1], (*res)[1]);
@@ -66,11 +79,12 @@ void Fp2::sqr(Element (*res), const Element &a) {
   }
 }
 
-void Fp2::sqr(Double (*res), const Element &a) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sqr(Double (*res), const Element &a) {
   if (gfp_qnr_ == 1) {  // one mul instead of 2 squares
-    GFp::Element t0, t1;
-    gfp->add(&t0, a[0], a[1]);
-    gfp->sub(&t1, a[0], a[1]);
+    Public<typename GFp::Element> t0, t1;
+    gfp->add_lazy(&t0, a[0], a[1]);
+    gfp->sub_lazy(&t1, a[0], a[1]);
     gfp->mul(&((*res)[0]), t0, t1);
   } else {
     gfp->sqr(&((*res)[0]), a[0]);
@@ -94,8 +108,9 @@ void Fp2::sqr(Double (*res), const Element &a) {
  7. return C = c0 + c1u;
  */
 
-void Fp2::inv(Element (*res), const Element &a) {
-  GFp::Element t1, t0;
+template<int nb_limbs>
+void Fp2N<nb_limbs>::inv(Element (*res), const Element &a) {
+  typename GFp::Element t1, t0;
 
   gfp->sqr(&t0, a[0]);
   gfp->sqr(&t1, a[1]);
@@ -109,14 +124,86 @@ void Fp2::inv(Element (*res), const Element &a) {
   gfp->opp(&((*res)[1]), (*res)[1]);
 }
 
-void Fp2::div(Element (*res), const Element &a, const Element &b) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n) {
+  simultaneous_inv(this, res, a, n, res);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n,
+                               Element *scratch) {
+  simultaneous_inv(this, res, a, n, scratch);
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul_batch(Element *res, const Element *a, const Element *b,
+                               size_t n) {
+  typename GFp::Element t[2 * BATCH_CHUNK], s0[BATCH_CHUNK], s1[BATCH_CHUNK];
+  size_t i, j, m;
+
+  // an array of n elements is an array of 2n GFp elements
+  static_assert(sizeof(Element) == 2 * sizeof(typename GFp::Element),
+                "Fp2 elements shall be made of two contiguous GFp ones");
+
+  for (j = 0; j < n; j += m) {
+    m = n - j < BATCH_CHUNK ? n - j : BATCH_CHUNK;
+    for (i = 0; i < m; i++) {
+      gfp->add_lazy(&(s0[i]), a[j + i][0], a[j + i][1]);
+      gfp->add_lazy(&(s1[i]), b[j + i][0], b[j + i][1]);
+    }
+    // t[2i] = a0.b0, t[2i+1] = a1.b1
+    gfp->mul_batch(t, &(a[j][0]), &(b[j][0]), 2 * m);
+    gfp->mul_batch(s0, s0, s1, m);
+
+    for (i = 0; i < m; i++) {
+      gfp->sub(&(res[j + i][1]), s0[i], t[2 * i]);
+      gfp->sub(&(res[j + i][1]), res[j + i][1], t[2 * i + 1]);
+      gfp->mul(&(t[2 * i + 1]), t[2 * i + 1], gfp_qnr_);
+      gfp->sub(&(res[j + i][0]), t[2 * i], t[2 * i + 1]);
+    }
+  }
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::sqr_batch(Element *res, const Element *a, size_t n) {
+  typename GFp::Element s0[BATCH_CHUNK], s1[BATCH_CHUNK];
+  typename GFp::Element u0[BATCH_CHUNK], u1[BATCH_CHUNK];
+  size_t i, j, m;
+
+  if (gfp_qnr_ != 1) {
+    mul_batch(res, a, a, n);
+    return;
+  }
+
+  // (a0 + a1).(a0 - a1) and 2.a0.a1
+  for (j = 0; j < n; j += m) {
+    m = n - j < BATCH_CHUNK ? n - j : BATCH_CHUNK;
+    for (i = 0; i < m; i++) {
+      gfp->add_lazy(&(s0[i]), a[j + i][0], a[j + i][1]);
+      gfp->sub_lazy(&(s1[i]), a[j + i][0], a[j + i][1]);
+      gfp->copy(&(u0[i]), a[j + i][0]);
+      gfp->copy(&(u1[i]), a[j + i][1]);
+    }
+    gfp->mul_batch(s0, s0, s1, m);
+    gfp->mul_batch(u0, u0, u1, m);
+
+    for (i = 0; i < m; i++) {
+      gfp->copy(&(res[j + i][0]), s0[i]);
+      gfp->add(&(res[j + i][1]), u0[i], u0[i]);
+    }
+  }
+}
+
+template<int nb_limbs>
+void Fp2N<nb_limbs>::div(Element (*res), const Element &a, const Element &b) {
   Element tmp;
   inv(&tmp, b);
   mul(res, a, tmp);
 }
 
-void Fp2::exp(Element (*res), const Element &a,
-              const GFp::Element &e) {
+template<int nb_limbs>
+void Fp2N<nb_limbs>::exp(Element (*res), const Element &a,
+                         const typename GFp::Element &e) {
   Element R;
   int i, l;
 
@@ -134,7 +221,8 @@ void Fp2::exp(Element (*res), const Element &a,
   ((*res)[1]).copy(R[1]);
 }
 
-ErrCode Fp2::frobenius(Element (*res), const Element &a, int i) {
+template<int nb_limbs>
+ErrCode Fp2N<nb_limbs>::frobenius(Element (*res), const Element &a, int i) {
   switch (i % 2) {
     case 0:
       ((*res)[0]).copy(a[0]);
@@ -149,8 +237,9 @@ ErrCode Fp2::frobenius(Element (*res), const Element &a, int i) {
   return ERR_OK;
 }
 
-void Fp2::mul_xsi(Element (*res), const Element &a) {
-  GFp::Element t0, t1;
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul_xsi(Element (*res), const Element &a) {
+  Public<typename GFp::Element> t0, t1;
   switch (xsi_) {
     case THREE_ONE:   // xsi = 3 + i
       gfp->mul(&t0, a[0], 3);
@@ -187,8 +276,9 @@ void Fp2::mul_xsi(Element (*res), const Element &a) {
   }
 }
 
-void Fp2::mul_xsi(Double (*res), const Double &a) {
-  GFp::Double t0, t1;
+template<int nb_limbs>
+void Fp2N<nb_limbs>::mul_xsi(Double (*res), const Double &a) {
+  Public<typename GFp::Double> t0, t1;
   switch (xsi_) {
     case TWO_ONE:   // xsi = 2 + i ; qnr = 1
       gfp->add(&t0, a[0], a[0]);
@@ -216,8 +306,9 @@ void Fp2::mul_xsi(Double (*res), const Double &a) {
   }
 }
 
-int Fp2::legendre(const Element &a) {
-  GFp::Element l, r;
+template<int nb_limbs>
+int Fp2N<nb_limbs>::legendre(const Element &a) {
+  typename GFp::Element l, r;
 
   gfp->sqr(&l, a[0]);
   gfp->sqr(&r, a[1]);
@@ -227,8 +318,9 @@ int Fp2::legendre(const Element &a) {
 }
 
 // based on formula from "implementing Cryptographic Pairings" by Michael Scott
-ErrCode Fp2::sqrt(Element (*res), const Element &a) {
-  GFp::Element tmp, l, r, norm;
+template<int nb_limbs>
+ErrCode Fp2N<nb_limbs>::sqrt(Element (*res), const Element &a) {
+  typename GFp::Element tmp, l, r, norm;
 
   if (legendre(a) == -1) {
     return ERR_NOT_SQUARE;
@@ -259,3 +351,5 @@ ErrCode Fp2::sqrt(Element (*res), const Element &a) {
 
 }  // namespace field
 }  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_FP2_MUL_HPP_
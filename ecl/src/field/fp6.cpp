@@ -0,0 +1,17 @@
+/**
+ * @file fp6.cpp
+ * @author Julien Kowalski
+ */
+
+#include "fp6_base.hpp"
+#include "fp6_mul.hpp"
+
+namespace ecl {
+namespace field {
+
+template class Fp6N<4> ;
+template class Fp6N<6> ;
+template class Fp6N<8> ;
+
+}  // namespace field
+}  // namespace ecl
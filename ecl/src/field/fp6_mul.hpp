@@ -1,29 +1,37 @@
 /*
- * @file fp6_mul.cpp
+ * @file fp6_mul.hpp
  * @author Julien Kowalski
  */
+
+#ifndef ECL_SRC_FIELD_FP6_MUL_HPP_
+#define ECL_SRC_FIELD_FP6_MUL_HPP_
 #include "ecl/field/GFp.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
+#include "inv_batch.hpp"
 
 using ecl::ErrCode;
 
 namespace ecl {
 namespace field {
 
-void Fp6::mul(Element *res, const Element &a, const Element &b) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul(Element *res, const Element &a, const Element &b) {
   Double tmp;
   mul(&tmp, a, b);
   reduce(res, tmp);
 }
 
-void Fp6::mul(Element *res, const Element &a, const Fp2::Element &b) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul(Element *res, const Element &a,
+                         const typename Fp2::Element &b) {
   fp2->mul(&((*res)[0]), a[0], b);
   fp2->mul(&((*res)[1]), a[1], b);
   fp2->mul(&((*res)[2]), a[2], b);
 }
 
-void Fp6::mul(Element *res, const Element &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul(Element *res, const Element &a, const ecl_digit b) {
   fp2->mul(&((*res)[0]), a[0], b);
   fp2->mul(&((*res)[1]), a[1], b);
   fp2->mul(&((*res)[2]), a[2], b);
@@ -39,9 +47,10 @@ void Fp6::mul(Element *res, const Element &a, const ecl_digit b) {
  6. c2 = (a0 + a2) * (b0 + b2) - t0 - t2 + t1;
  */
 
-void Fp6::mul(Double *res, const Element &a, const Element &b) {
-  Fp2::Double t0, t1, t2;
-  Fp2::Element s0, s1;
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul(Double *res, const Element &a, const Element &b) {
+  typename Fp2::Double t0, t1, t2;
+  typename Fp2::Element s0, s1;
 
   fp2->mul(&t0, a[0], b[0]);
   fp2->mul(&t1, a[1], b[1]);
@@ -71,13 +80,15 @@ void Fp6::mul(Double *res, const Element &a, const Element &b) {
   fp2->add(&((*res)[2]), (*res)[2], t1);
 }
 
-void Fp6::mul(Double *res, const Double &a, const ecl_digit b) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul(Double *res, const Double &a, const ecl_digit b) {
   fp2->mul(&((*res)[0]), a[0], b);
   fp2->mul(&((*res)[1]), a[1], b);
   fp2->mul(&((*res)[2]), a[2], b);
 }
 
-void Fp6::sqr(Element *res, const Element &a) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::sqr(Element *res, const Element &a) {
   Double d;
   sqr(&d, a);
   reduce(res, d);
@@ -99,9 +110,10 @@ void Fp6::sqr(Element *res, const Element &a) {
  11. return C = c0 + c1v + c2v^2;
  */
 
-void Fp6::sqr(Double *res, const Element &a) {
-  Fp2::Double c3, c4, c5;
-  Fp2::Element t;
+template<int nb_limbs>
+void Fp6N<nb_limbs>::sqr(Double *res, const Element &a) {
+  typename Fp2::Double c3, c4, c5;
+  typename Fp2::Element t;
 
   fp2->mul(&c4, a[0], a[1]);
   fp2->add(&c4, c4, c4);
@@ -150,9 +162,10 @@ void Fp6::sqr(Double *res, const Element &a) {
  16. c2 =  c2 * t6;
  */
 
-void Fp6::inv(Element *res, const Element &a) {
-  Fp2::Element t0, t1, t2, t3, t4, t5, t6;
-  Fp2::Element c0, c1, c2;
+template<int nb_limbs>
+void Fp6N<nb_limbs>::inv(Element *res, const Element &a) {
+  typename Fp2::Element t0, t1, t2, t3, t4, t5, t6;
+  typename Fp2::Element c0, c1, c2;
 
   fp2->sqr(&t0, a[0]);
   fp2->sqr(&t1, a[1]);
@@ -186,13 +199,27 @@ void Fp6::inv(Element *res, const Element &a) {
   fp2->mul(&((*res)[2]), c2, t6);
 }
 
-void Fp6::div(Element *res, const Element &a, const Element &b) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n) {
+  simultaneous_inv(this, res, a, n, res);
+}
+
+template<int nb_limbs>
+void Fp6N<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n,
+                               Element *scratch) {
+  simultaneous_inv(this, res, a, n, scratch);
+}
+
+template<int nb_limbs>
+void Fp6N<nb_limbs>::div(Element *res, const Element &a, const Element &b) {
   Element tmp;
   inv(&tmp, b);
   mul(res, a, tmp);
 }
 
-void Fp6::exp(Element *res, const Element &a, const GFp::Element &e) {
+template<int nb_limbs>
+void Fp6N<nb_limbs>::exp(Element *res, const Element &a,
+                         const typename GFp::Element &e) {
   Element R;
   int i, l;
 
@@ -208,12 +235,14 @@ void Fp6::exp(Element *res, const Element &a, const GFp::Element &e) {
   copy(res, R);
 }
 
-ErrCode Fp6::frobenius(Element *res, const Element &a, int i) {
+template<int nb_limbs>
+ErrCode Fp6N<nb_limbs>::frobenius(Element *res, const Element &a, int i) {
   return ERR_NOT_IMPLEMENTED;
 }
 
-void Fp6::mul_vi(Element *res, const Element &a) {
-  Fp2::Element tmp;
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul_vi(Element *res, const Element &a) {
+  typename Fp2::Element tmp;
 
   fp2->copy(&tmp, a[0]);
   fp2->mul_xsi(&((*res)[0]), a[2]);
@@ -221,8 +250,9 @@ void Fp6::mul_vi(Element *res, const Element &a) {
   fp2->copy(&((*res)[1]), tmp);
 }
 
-void Fp6::mul_vi(Double *res, const Double &a) {
-  Fp2::Double tmp;
+template<int nb_limbs>
+void Fp6N<nb_limbs>::mul_vi(Double *res, const Double &a) {
+  typename Fp2::Double tmp;
 
   fp2->copy(&tmp, a[0]);
   fp2->mul_xsi(&((*res)[0]), a[2]);
@@ -232,3 +262,5 @@ void Fp6::mul_vi(Double *res, const Double &a) {
 
 }  // namespace field
 }  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_FP6_MUL_HPP_
@@ -0,0 +1,63 @@
+/**
+ * @file fr.cpp
+ * @author Julien Kowalski
+ */
+
+#include <cstring>
+
+#include "ecl/field/Fr.h"
+
+namespace ecl {
+namespace field {
+
+Fr::Fr(const Element &r)
+    : GFp(r) {
+  Element::barrett_setup(&mu_, p_);
+}
+
+void Fr::fromInt(Element *res, const Element &k) {
+  /* k < R and R2 < r so k.R2 < r.R : MonPro(k, R^2) = k.R mod r */
+  mul(res, k, R2_);
+}
+
+void Fr::toInt(Element *k, const Element &a) {
+  Secret<Double> t;
+
+  memcpy(t.val, a.val, sizeof(a.val));
+  reduce(k, t);
+}
+
+void Fr::reduce_wide(Element *k, const Double &h) {
+  Element::barrett_reduce(k, h, p_, mu_);
+}
+
+void Fr::fromWide(Element *res, const Double &h) {
+  Secret<Element> k;
+
+  reduce_wide(&k, h);
+  fromInt(res, k);
+}
+
+void Fr::get_wNAF(int *wNaf, int *wNaf_sz, const Element &a, int w) {
+  Secret<Element> k;
+
+  toInt(&k, a);
+  k.get_wNAF(wNaf, wNaf_sz, w);
+}
+
+void Fr::fromWNAF(Element *res, const int *wNaf, int wNaf_sz) {
+  Element d;
+  int i;
+
+  zero(res);
+  for (i = wNaf_sz - 1; i >= 0; i--) {
+    add(res, *res, *res);
+    if (wNaf[i] != 0) {
+      set(&d, wNaf[i]);
+      add(res, *res, d);
+    }
+  }
+}
+
+}  // namespace field
+}  // namespace ecl
@@ -0,0 +1,25 @@
+/**
+ * @file gfp.cpp
+ * @author Julien Kowalski
+ */
+
+#include "gfp_base.hpp"
+#include "gfp_addsub.hpp"
+#include "gfp_cmp.hpp"
+#include "gfp_mul.hpp"
+#include "gfp_red.hpp"
+#include "gfp_inv.hpp"
+#include "gfp_batch.hpp"
+#include "gfp_exp.hpp"
+#include "gfp_codec.hpp"
+#include "gfp_sqrt.hpp"
+
+namespace ecl {
+namespace field {
+
+template class GFpN<4> ;
+template class GFpN<6> ;
+template class GFpN<8> ;
+
+}  // namespace field
+}  // namespace ecl
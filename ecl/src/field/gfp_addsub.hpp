@@ -0,0 +1,125 @@
+/**
+ * @file gfp_addsub.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_ADDSUB_HPP_
+#define ECL_SRC_FIELD_GFP_ADDSUB_HPP_
+
+#include <cassert>
+
+#include "ecl/field/GFp.h"
+#include "../asm/arch.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add(Element *res, const Element &a, const Element &b) {
+  register unsigned char carry = 0;
+  carry = FixedSizedInt<nb_limbs>::add(res, a, b);
+  if (carry || (cmp(*res, p_) != 1)) {
+    FixedSizedInt<nb_limbs>::sub(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add_nr(Element *res, const Element &a, const Element b) {
+  FixedSizedInt<nb_limbs>::add(res, a, b);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add_lazy(Element *res, const Element &a,
+                              const Element &b) {
+  assert(cmp(a, p_) != -1 && cmp(b, p_) != -1);
+  if (!lazy_) {
+    return add(res, a, b);
+  }
+  FixedSizedInt<nb_limbs>::add(res, a, b);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add(Element *res, const Element &a, const ecl_digit b) {
+  register unsigned char carry = 0;
+  carry = FixedSizedInt<nb_limbs>::add(res, a, b);
+  if (carry || (cmp(*res, p_) != 1)) {
+    FixedSizedInt<nb_limbs>::sub(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add_nr(Element *res, const Element &a, const ecl_digit b) {
+  FixedSizedInt<nb_limbs>::add(res, a, b);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::add(Double *res, const Double &a, const Double &b) {
+  register unsigned char carry = 0;
+  carry = FixedSizedInt<2 * nb_limbs>::add(res, a, b);
+  if (carry || (cmp_p(*res) == -1)) {  // cmp_p mandatory...
+    FixedSizedInt<nb_limbs>::sub_msw(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sub(Element *res, const Element &a, const Element &b) {
+  register unsigned char borrow = 0;
+  borrow = FixedSizedInt<nb_limbs>::sub(res, a, b);
+  if (borrow) {
+    FixedSizedInt<nb_limbs>::add(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sub(Element *res, const Element &a, const ecl_digit b) {
+  register unsigned char borrow = 0;
+  borrow = FixedSizedInt<nb_limbs>::sub(res, a, b);
+  if (borrow) {
+    FixedSizedInt<nb_limbs>::add(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sub_lazy(Element *res, const Element &a,
+                              const Element &b) {
+  Element t(UNINITIALIZED);
+
+  assert(cmp(a, p_) != -1 && cmp(b, p_) != -1);
+  if (!lazy_) {
+    return sub(res, a, b);
+  }
+  FixedSizedInt<nb_limbs>::sub(&t, p_, b);
+  FixedSizedInt<nb_limbs>::add(res, a, t);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sub(Double *res, const Double &a, const Double &b) {
+  register unsigned char borrow = 0;
+  borrow = FixedSizedInt<2 * nb_limbs>::sub(res, a, b);
+  if (borrow) {
+    FixedSizedInt<nb_limbs>::add_msw(res, *res, p_);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sub_nr(Double *res, const Double &a, const Double &b) {
+  FixedSizedInt<2 * nb_limbs>::sub(res, a, b);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::opp(Element *res, const Element &a) {
+  FixedSizedInt<nb_limbs>::sub(res, p_, a);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::opp(Double *res, const Double &a) {
+  FixedSizedInt<2 * nb_limbs>::sub(res, Rp_, a);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_ADDSUB_HPP_
@@ -0,0 +1,116 @@
+/**
+ * @file gfp_base.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_BASE_HPP_
+#define ECL_SRC_FIELD_GFP_BASE_HPP_
+
+#include <iostream>
+
+#include <cstring>
+#include <string>
+
+#include "ecl/field/GFp.h"
+#include "../asm/dispatch.h"
+#include "montgomery.hpp"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+GFpN<nb_limbs>::GFpN(const string p) {
+  int s;
+  p_.fromString(&s, p);
+  init();
+}
+
+template<int nb_limbs>
+GFpN<nb_limbs>::GFpN(const Element &p) {
+  p_.copy(p);
+  init();
+}
+
+template<int nb_limbs>
+GFpN<nb_limbs>::~GFpN() {
+  m_ = 0;
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::zero(Element *a) {
+  a->zero();
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::one(Element *a) {
+  a->copy(R_);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::set(Element *a, const int v) {
+  Element vv;
+  if (v < 0) {
+    vv.set(-v);
+    mul(&vv, vv, R2_);
+    opp(&vv, vv);
+  } else {
+    vv.set(v);
+    mul(&vv, vv, R2_);
+  }
+  a->copy(vv);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::init() {
+  montSetup(&m_, p_);
+  // the BMI2/ADX kernels are for NB_LIMBS limbs only
+  use_mulx_ = (nb_limbs == NB_LIMBS) && kernels()->mulx;
+  p256_ = isP256(p_);
+  lazy_ = (p_.val[nb_limbs - 1] >> (DIGIT_BITS - 2)) == 0;
+  byte_size_ = (p_.count_bits() + 7) / 8;
+  memcpy(Rp_.val + nb_limbs, p_.val, nb_limbs * sizeof(ecl_digit));
+
+  // R, R^2 and R^3 mod p ; R = 2^(nb_limbs*DIGIT_BITS)
+  montgomery::powers_of_R(&R_, &R2_, &R3_, p_);
+
+  init_exp();
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::fromString(Element *res, const string str) {
+  ErrCode rv;
+  int sign;
+
+  rv = res->fromString(&sign, str);
+  if (rv != ERR_OK) {
+    return rv;
+  }
+  mul(res, *res, R2_);
+
+  if (sign < 0) {
+    opp(res, *res);
+  }
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::rand(Element *res,
+                          int (*f_rng)(unsigned char *, int, void *),
+                          void *p_rng) {
+  int bit_size = p_.count_bits();
+  ecl_digit mask = (ecl_digit) -1;
+  for (int i = 0; i <= (nb_limbs * DIGIT_BITS) - bit_size; i++) {
+    mask = mask / 2;
+  }
+  do {
+    f_rng((unsigned char *) res->val, nb_limbs * sizeof(ecl_digit), p_rng);
+    res->val[nb_limbs - 1] &= mask;
+  } while (this->cmp(*res, this->p_) != 1);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_BASE_HPP_
@@ -0,0 +1,454 @@
+/**
+ * @file gfp_batch.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_BATCH_HPP_
+#define ECL_SRC_FIELD_GFP_BATCH_HPP_
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+
+#include "ecl/field/GFp.h"
+
+#include "../asm/dispatch.h"
+
+#if defined(ARCH_X86_64)
+#include <immintrin.h>
+#endif
+
+namespace ecl {
+namespace field {
+
+#if defined(ARCH_X86_64)
+/*
+ * Four-way Montgomery multiplication with AVX2.
+ *
+ * The four operands of a batch are transposed to SoA form : limb j of the
+ * four elements lies in the four 64 bit lanes of one ymm register. Limbs are
+ * 29 bits wide, 9 limbs hold 261 bits, so that the 32x32 -> 64 bits vpmuludq
+ * products and their sums in the 64 bit lanes never overflow.
+ *
+ * The Montgomery radix of the vector loop is 2^261 instead of R = 2^256,
+ * b is thus shifted left by 5 bits on conversion : (a.32b)/2^261 = ab/R.
+ */
+namespace avx2 {
+
+static const int kLimbs = 9;
+static const int kBits = 29;
+static const uint64_t kMask = (1ULL << kBits) - 1;
+
+/** transposes a 4x4 matrix of 64 bit words */
+__attribute__((target("avx2")))
+static inline void transpose(__m256i *r0, __m256i *r1, __m256i *r2,
+                             __m256i *r3) {
+  __m256i t0 = _mm256_unpacklo_epi64(*r0, *r1);
+  __m256i t1 = _mm256_unpackhi_epi64(*r0, *r1);
+  __m256i t2 = _mm256_unpacklo_epi64(*r2, *r3);
+  __m256i t3 = _mm256_unpackhi_epi64(*r2, *r3);
+  *r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+  *r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+  *r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+  *r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+/** converts 4 consecutive elements to 9 limbs of 29 bits, shifted left by
+ * sh bits */
+__attribute__((target("avx2")))
+static inline void load(__m256i *x, const ecl_digit *e, int sh) {
+  const __m256i mask = _mm256_set1_epi64x(kMask);
+  __m256i w[4];
+  int j, pos, k, o;
+
+  for (k = 0; k < 4; k++) {
+    w[k] = _mm256_loadu_si256((const __m256i *) (e + k * NB_LIMBS));
+  }
+  transpose(&w[0], &w[1], &w[2], &w[3]);
+
+  x[0] = _mm256_and_si256(_mm256_slli_epi64(w[0], sh), mask);
+  for (j = 1; j < kLimbs; j++) {
+    pos = j * kBits - sh;
+    k = pos / 64;
+    o = pos % 64;
+    x[j] = _mm256_srli_epi64(w[k], o);
+    if (o > 64 - kBits && k < 3) {
+      x[j] = _mm256_or_si256(x[j], _mm256_slli_epi64(w[k + 1], 64 - o));
+    }
+    x[j] = _mm256_and_si256(x[j], mask);
+  }
+}
+
+/** converts 9 normalized limbs back to 4 consecutive elements */
+__attribute__((target("avx2")))
+static inline void store(ecl_digit *e, const __m256i *x) {
+  __m256i w[4];
+  int j, k, pos;
+
+  for (k = 0; k < 4; k++) {
+    w[k] = _mm256_setzero_si256();
+    for (j = 0; j < kLimbs; j++) {
+      pos = j * kBits - 64 * k;
+      if (pos >= 64 || pos <= -kBits) {
+        continue;
+      }
+      if (pos >= 0) {
+        w[k] = _mm256_or_si256(w[k], _mm256_slli_epi64(x[j], pos));
+      } else {
+        w[k] = _mm256_or_si256(w[k], _mm256_srli_epi64(x[j], -pos));
+      }
+    }
+  }
+  transpose(&w[0], &w[1], &w[2], &w[3]);
+  for (k = 0; k < 4; k++) {
+    _mm256_storeu_si256((__m256i *) (e + k * NB_LIMBS), w[k]);
+  }
+}
+
+/** res = a.b / 2^261 mod p, a and b in SoA form, p also, m = -1/p mod 2^29.
+ * If a.b < p.2^261, the result is fully reduced.
+ */
+__attribute__((target("avx2")))
+static inline void montmul(__m256i *res, const __m256i *a, const __m256i *b,
+                           const __m256i *p, __m256i m) {
+  const __m256i mask = _mm256_set1_epi64x(kMask);
+  __m256i t[kLimbs], d[kLimbs], q, c, borrow;
+  int i, j;
+
+  for (j = 0; j < kLimbs; j++) {
+    t[j] = _mm256_setzero_si256();
+  }
+  /* each round adds less than 2^59 to each accumulator, which holds the
+   * contributions of at most 9 rounds : no overflow */
+  for (i = 0; i < kLimbs; i++) {
+    for (j = 0; j < kLimbs; j++) {
+      t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(a[i], b[j]));
+    }
+    q = _mm256_and_si256(_mm256_mul_epu32(t[0], m), mask);
+    for (j = 0; j < kLimbs; j++) {
+      t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(q, p[j]));
+    }
+    /* t[0] is now a multiple of 2^29 */
+    c = _mm256_srli_epi64(t[0], kBits);
+    for (j = 0; j < kLimbs - 1; j++) {
+      t[j] = t[j + 1];
+    }
+    t[0] = _mm256_add_epi64(t[0], c);
+    t[kLimbs - 1] = _mm256_setzero_si256();
+  }
+
+  /* carry propagation, t < 2p */
+  for (j = 0; j < kLimbs - 1; j++) {
+    t[j + 1] = _mm256_add_epi64(t[j + 1], _mm256_srli_epi64(t[j], kBits));
+    t[j] = _mm256_and_si256(t[j], mask);
+  }
+
+  /* d = t - p, keep t on borrow */
+  borrow = _mm256_setzero_si256();
+  for (j = 0; j < kLimbs; j++) {
+    d[j] = _mm256_sub_epi64(_mm256_sub_epi64(t[j], p[j]), borrow);
+    borrow = _mm256_srli_epi64(d[j], 63);
+    d[j] = _mm256_and_si256(d[j], mask);
+  }
+  borrow = _mm256_sub_epi64(_mm256_setzero_si256(), borrow);
+  for (j = 0; j < kLimbs; j++) {
+    res[j] = _mm256_blendv_epi8(d[j], t[j], borrow);
+  }
+}
+
+}  // namespace avx2
+
+/** Montgomery multiplication of n elements, n multiple of 4 */
+__attribute__((target("avx2")))
+void avx2_montmul_4x(ecl_digit *res, const ecl_digit *a, const ecl_digit *b,
+                     size_t n, const ecl_digit *p) {
+  using namespace avx2;
+  __m256i vp[kLimbs], va[kLimbs], vb[kLimbs], vr[kLimbs], m;
+  uint64_t pl[kLimbs], inv;
+  int j;
+  size_t i;
+
+  /* p in 29 bits limbs, m = -1/p mod 2^29 by Newton iteration */
+  for (j = 0; j < kLimbs; j++) {
+    int pos = j * kBits, k = pos / 64, o = pos % 64;
+    pl[j] = p[k] >> o;
+    if (o > 64 - kBits && k < NB_LIMBS - 1) {
+      pl[j] |= p[k + 1] << (64 - o);
+    }
+    pl[j] &= kMask;
+    vp[j] = _mm256_set1_epi64x(pl[j]);
+  }
+  inv = pl[0];
+  for (j = 0; j < 5; j++) {
+    inv *= 2 - pl[0] * inv;
+  }
+  m = _mm256_set1_epi64x((0 - inv) & kMask);
+
+  for (i = 0; i < n; i += 4) {
+    load(va, a, 0);
+    load(vb, b, 5);
+    montmul(vr, va, vb, vp, m);
+    store(res, vr);
+    a += 4 * NB_LIMBS;
+    b += 4 * NB_LIMBS;
+    res += 4 * NB_LIMBS;
+  }
+}
+
+/*
+ * Eight-way Montgomery multiplication with AVX-512 IFMA.
+ *
+ * Same SoA layout as the AVX2 kernel, with eight elements per zmm register
+ * and 5 limbs of 52 bits, multiplied by vpmadd52luq / vpmadd52huq which
+ * accumulate the low and high 52 bits of the 104 bits products.
+ * The Montgomery radix of the vector loop is 2^260, b is shifted left by
+ * 4 bits on conversion : (a.16b)/2^260 = ab/R.
+ */
+namespace ifma {
+
+static const int kLimbs = 5;
+static const int kBits = 52;
+static const uint64_t kMask = (1ULL << kBits) - 1;
+
+#define ECL_IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+
+static const int64_t kLo[8] = { 0, 4, 8, 12, 1, 5, 9, 13 };
+static const int64_t kHi[8] = { 2, 6, 10, 14, 3, 7, 11, 15 };
+static const int64_t kLo2[8] = { 0, 1, 2, 3, 8, 9, 10, 11 };
+static const int64_t kHi2[8] = { 4, 5, 6, 7, 12, 13, 14, 15 };
+
+/** transposes 8 elements of 4 words, r[k] holding elements 2k and 2k+1,
+ * to w[k] holding word k of the 8 elements */
+ECL_IFMA_TARGET
+static inline void transpose(__m512i *w, const __m512i *r) {
+  const __m512i lo = _mm512_loadu_si512(kLo), hi = _mm512_loadu_si512(kHi);
+  const __m512i lo2 = _mm512_loadu_si512(kLo2);
+  const __m512i hi2 = _mm512_loadu_si512(kHi2);
+  __m512i u0, u1, v0, v1;
+
+  u0 = _mm512_permutex2var_epi64(r[0], lo, r[1]);
+  u1 = _mm512_permutex2var_epi64(r[0], hi, r[1]);
+  v0 = _mm512_permutex2var_epi64(r[2], lo, r[3]);
+  v1 = _mm512_permutex2var_epi64(r[2], hi, r[3]);
+  w[0] = _mm512_permutex2var_epi64(u0, lo2, v0);
+  w[1] = _mm512_permutex2var_epi64(u0, hi2, v0);
+  w[2] = _mm512_permutex2var_epi64(u1, lo2, v1);
+  w[3] = _mm512_permutex2var_epi64(u1, hi2, v1);
+}
+
+/** inverse of transpose() */
+ECL_IFMA_TARGET
+static inline void untranspose(__m512i *r, const __m512i *w) {
+  const __m512i lo = _mm512_loadu_si512(kLo), hi = _mm512_loadu_si512(kHi);
+  const __m512i lo2 = _mm512_loadu_si512(kLo2);
+  const __m512i hi2 = _mm512_loadu_si512(kHi2);
+  __m512i u0, u1, v0, v1;
+
+  u0 = _mm512_permutex2var_epi64(w[0], lo2, w[1]);
+  u1 = _mm512_permutex2var_epi64(w[2], lo2, w[3]);
+  v0 = _mm512_permutex2var_epi64(w[0], hi2, w[1]);
+  v1 = _mm512_permutex2var_epi64(w[2], hi2, w[3]);
+  r[0] = _mm512_permutex2var_epi64(u0, lo, u1);
+  r[1] = _mm512_permutex2var_epi64(u0, hi, u1);
+  r[2] = _mm512_permutex2var_epi64(v0, lo, v1);
+  r[3] = _mm512_permutex2var_epi64(v0, hi, v1);
+}
+
+/** converts 8 consecutive elements to 5 limbs of 52 bits, shifted left by
+ * sh bits */
+ECL_IFMA_TARGET
+static inline void load(__m512i *x, const ecl_digit *e, int sh) {
+  const __m512i mask = _mm512_set1_epi64(kMask);
+  __m512i r[4], w[4];
+  int j, pos, k, o;
+
+  for (k = 0; k < 4; k++) {
+    r[k] = _mm512_loadu_si512(e + 2 * k * NB_LIMBS);
+  }
+  transpose(w, r);
+
+  x[0] = _mm512_and_si512(_mm512_slli_epi64(w[0], sh), mask);
+  for (j = 1; j < kLimbs; j++) {
+    pos = j * kBits - sh;
+    k = pos / 64;
+    o = pos % 64;
+    x[j] = _mm512_srli_epi64(w[k], o);
+    if (o > 64 - kBits && k < 3) {
+      x[j] = _mm512_or_si512(x[j], _mm512_slli_epi64(w[k + 1], 64 - o));
+    }
+    x[j] = _mm512_and_si512(x[j], mask);
+  }
+}
+
+/** converts 5 normalized limbs back to 8 consecutive elements */
+ECL_IFMA_TARGET
+static inline void store(ecl_digit *e, const __m512i *x) {
+  __m512i r[4], w[4];
+  int j, k, pos;
+
+  for (k = 0; k < 4; k++) {
+    w[k] = _mm512_setzero_si512();
+    for (j = 0; j < kLimbs; j++) {
+      pos = j * kBits - 64 * k;
+      if (pos >= 64 || pos <= -kBits) {
+        continue;
+      }
+      if (pos >= 0) {
+        w[k] = _mm512_or_si512(w[k], _mm512_slli_epi64(x[j], pos));
+      } else {
+        w[k] = _mm512_or_si512(w[k], _mm512_srli_epi64(x[j], -pos));
+      }
+    }
+  }
+  untranspose(r, w);
+  for (k = 0; k < 4; k++) {
+    _mm512_storeu_si512(e + 2 * k * NB_LIMBS, r[k]);
+  }
+}
+
+/** res = a.b / 2^260 mod p, a and b in SoA form, p also, m = -1/p mod 2^52.
+ * If a.b < p.2^260, the result is fully reduced.
+ */
+ECL_IFMA_TARGET
+static inline void montmul(__m512i *res, const __m512i *a, const __m512i *b,
+                           const __m512i *p, __m512i m) {
+  const __m512i mask = _mm512_set1_epi64(kMask);
+  const __m512i zero = _mm512_setzero_si512();
+  __m512i t[kLimbs + 1], d[kLimbs], q, c, borrow;
+  __mmask8 keep;
+  int i, j;
+
+  for (j = 0; j <= kLimbs; j++) {
+    t[j] = zero;
+  }
+  /* each round adds less than 2^54 to each accumulator : no overflow */
+  for (i = 0; i < kLimbs; i++) {
+    for (j = 0; j < kLimbs; j++) {
+      t[j] = _mm512_madd52lo_epu64(t[j], a[i], b[j]);
+      t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[i], b[j]);
+    }
+    /* only the low 52 bits of t[0] are used */
+    q = _mm512_madd52lo_epu64(zero, t[0], m);
+    for (j = 0; j < kLimbs; j++) {
+      t[j] = _mm512_madd52lo_epu64(t[j], q, p[j]);
+      t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], q, p[j]);
+    }
+    /* t[0] is now a multiple of 2^52 */
+    c = _mm512_srli_epi64(t[0], kBits);
+    for (j = 0; j < kLimbs; j++) {
+      t[j] = t[j + 1];
+    }
+    t[0] = _mm512_add_epi64(t[0], c);
+    t[kLimbs] = zero;
+  }
+
+  /* carry propagation, t < 2p */
+  for (j = 0; j < kLimbs - 1; j++) {
+    t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], kBits));
+    t[j] = _mm512_and_si512(t[j], mask);
+  }
+
+  /* d = t - p, keep t on borrow */
+  borrow = zero;
+  for (j = 0; j < kLimbs; j++) {
+    d[j] = _mm512_sub_epi64(_mm512_sub_epi64(t[j], p[j]), borrow);
+    borrow = _mm512_srli_epi64(d[j], 63);
+    d[j] = _mm512_and_si512(d[j], mask);
+  }
+  keep = _mm512_test_epi64_mask(borrow, borrow);
+  for (j = 0; j < kLimbs; j++) {
+    res[j] = _mm512_mask_blend_epi64(keep, d[j], t[j]);
+  }
+}
+
+#undef ECL_IFMA_TARGET
+
+}  // namespace ifma
+
+/** Montgomery multiplication of n elements, n multiple of 8 */
+__attribute__((target("avx512f,avx512ifma")))
+void ifma_montmul_8x(ecl_digit *res, const ecl_digit *a, const ecl_digit *b,
+                     size_t n, const ecl_digit *p) {
+  using namespace ifma;
+  __m512i vp[kLimbs], va[kLimbs], vb[kLimbs], vr[kLimbs], m;
+  uint64_t pl[kLimbs], inv;
+  int j;
+  size_t i;
+
+  /* p in 52 bits limbs, m = -1/p mod 2^52 by Newton iteration */
+  for (j = 0; j < kLimbs; j++) {
+    int pos = j * kBits, k = pos / 64, o = pos % 64;
+    pl[j] = p[k] >> o;
+    if (o > 64 - kBits && k < NB_LIMBS - 1) {
+      pl[j] |= p[k + 1] << (64 - o);
+    }
+    pl[j] &= kMask;
+    vp[j] = _mm512_set1_epi64(pl[j]);
+  }
+  inv = pl[0];
+  for (j = 0; j < 6; j++) {
+    inv *= 2 - pl[0] * inv;
+  }
+  m = _mm512_set1_epi64((0 - inv) & kMask);
+
+  for (i = 0; i < n; i += 8) {
+    load(va, a, 0);
+    load(vb, b, 4);
+    montmul(vr, va, vb, vp, m);
+    store(res, vr);
+    a += 8 * NB_LIMBS;
+    b += 8 * NB_LIMBS;
+    res += 8 * NB_LIMBS;
+  }
+}
+#endif
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::mul_batch(Element *res, const Element *a, const Element *b,
+                               size_t n) {
+  const Kernels *k = kernels();
+  size_t i = 0, m;
+
+  if (nb_limbs != NB_LIMBS) {
+    k = NULL;  // the SIMD kernels are for NB_LIMBS limbs only
+  }
+  if (k != NULL && k->montmul_8x != NULL) {
+    i = n & ~((size_t) 7);
+    k->montmul_8x(res->val, a->val, b->val, i, p_.val);
+  }
+  // the mulx P-256 reduction beats the four-way kernel
+  if (k != NULL && k->montmul_4x != NULL && !(use_mulx_ && p256_)) {
+    m = (n - i) & ~((size_t) 3);
+    k->montmul_4x(res[i].val, a[i].val, b[i].val, m, p_.val);
+    i += m;
+  }
+  for (; i < n; i++) {
+    mul(&(res[i]), a[i], b[i]);
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sqr_batch(Element *res, const Element *a, size_t n) {
+  const Kernels *k = kernels();
+  size_t i = 0, m;
+
+  if (nb_limbs != NB_LIMBS) {
+    k = NULL;  // the SIMD kernels are for NB_LIMBS limbs only
+  }
+  if (k != NULL && k->montmul_8x != NULL) {
+    i = n & ~((size_t) 7);
+    k->montmul_8x(res->val, a->val, a->val, i, p_.val);
+  }
+  if (k != NULL && k->montmul_4x != NULL && !(use_mulx_ && p256_)) {
+    m = (n - i) & ~((size_t) 3);
+    k->montmul_4x(res[i].val, a[i].val, a[i].val, m, p_.val);
+    i += m;
+  }
+  for (; i < n; i++) {
+    sqr(&(res[i]), a[i]);
+  }
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_BATCH_HPP_
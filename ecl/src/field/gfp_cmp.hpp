@@ -0,0 +1,95 @@
+/**
+ * @file gfp_cmp.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_CMP_HPP_
+#define ECL_SRC_FIELD_GFP_CMP_HPP_
+
+#include "ecl/field/GFp.h"
+#include "../asm/arch.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+bool GFpN<nb_limbs>::isOne(const Element &a) {
+  return (cmp(a, R_) == 0);
+}
+
+template<int nb_limbs>
+bool GFpN<nb_limbs>::isZero(const Element &a) {
+  return a.isZero();
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::copy(Element *res, const Element &a) {
+  res->copy(a);
+}
+
+template<int nb_limbs>
+int GFpN<nb_limbs>::cmp(const Element &a, const Element &b) {
+  int x;
+  for (x = nb_limbs - 1; x >= 0; x--) {
+    if (a.val[x] > b.val[x]) {
+      return -1;
+    } else if (a.val[x] < b.val[x]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template<int nb_limbs>
+int GFpN<nb_limbs>::cmp_p(const Double &a) {
+  int x;
+  for (x = nb_limbs - 1; x >= 0; x--) {
+    if (a.val[x + nb_limbs] > p_.val[x]) {
+      return -1;
+    } else if (a.val[x + nb_limbs] < p_.val[x]) {
+      return 1;
+    }
+  }
+  for (x = nb_limbs - 1; x >= 0; x--) {
+    if (a.val[x] != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+template<int nb_limbs>
+int GFpN<nb_limbs>::cmp(const Double &a, const Double &b) {
+  int x;
+  for (x = 2 * nb_limbs - 1; x >= 0; x--) {
+    if (a.val[x] > b.val[x]) {
+      return -1;
+    } else if (a.val[x] < b.val[x]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template<int nb_limbs>
+int GFpN<nb_limbs>::cmp(const Element &a, int b) {
+  Element bb;
+  ecl_digit val;
+
+  if (b < 0) {
+    val = -b;
+    set(&bb, val);
+    opp(&bb, bb);
+  } else {
+    val = b;
+    set(&bb, val);
+  }
+  return cmp(a, bb);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_CMP_HPP_
@@ -0,0 +1,92 @@
+/**
+ * @file gfp_codec.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_CODEC_HPP_
+#define ECL_SRC_FIELD_GFP_CODEC_HPP_
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+
+#include "ecl/field/GFp.h"
+
+namespace ecl {
+namespace field {
+
+/** number of elements converted per mul_batch() call of the batch codecs */
+static const size_t CODEC_CHUNK = 16;
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::toBytes(unsigned char *out, const Element &a,
+                             ByteOrder order) {
+  Element t(UNINITIALIZED), u;
+
+  /* MonPro(a.R, 1) = a */
+  u.set(1);
+  mul(&t, a, u);
+  t.toBytes(out, byte_size_, order);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::toBytes(unsigned char *out, const Element *a, size_t n,
+                             ByteOrder order) {
+  Element t[CODEC_CHUNK], u[CODEC_CHUNK];
+  size_t i, j, m;
+
+  for (j = 0; j < CODEC_CHUNK; j++) {
+    u[j].set(1);
+  }
+  for (i = 0; i < n; i += m) {
+    m = n - i < CODEC_CHUNK ? n - i : CODEC_CHUNK;
+    mul_batch(t, a + i, u, m);
+    for (j = 0; j < m; j++) {
+      t[j].toBytes(out + (i + j) * byte_size_, byte_size_, order);
+    }
+  }
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                  ByteOrder order) {
+  Element t(UNINITIALIZED);
+
+  t.fromBytes(in, byte_size_, order);
+  if (cmp(t, p_) != 1) {
+    return ERR_INVALID_VALUE;
+  }
+  mul(res, t, R2_);
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::fromBytes(Element *res, const unsigned char *in,
+                                  size_t n, ByteOrder order) {
+  Element t[CODEC_CHUNK], r2[CODEC_CHUNK];
+  size_t i, j, m;
+
+  // check every integer first, res is left unchanged on error
+  for (i = 0; i < n; i++) {
+    t[0].fromBytes(in + i * byte_size_, byte_size_, order);
+    if (cmp(t[0], p_) != 1) {
+      return ERR_INVALID_VALUE;
+    }
+  }
+
+  for (j = 0; j < CODEC_CHUNK; j++) {
+    r2[j].copy(R2_);
+  }
+  for (i = 0; i < n; i += m) {
+    m = n - i < CODEC_CHUNK ? n - i : CODEC_CHUNK;
+    for (j = 0; j < m; j++) {
+      t[j].fromBytes(in + (i + j) * byte_size_, byte_size_, order);
+    }
+    mul_batch(res + i, t, r2, m);
+  }
+  return ERR_OK;
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_CODEC_HPP_
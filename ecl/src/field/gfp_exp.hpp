@@ -0,0 +1,150 @@
+/**
+ * @file gfp_exp.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_EXP_HPP_
+#define ECL_SRC_FIELD_GFP_EXP_HPP_
+
+#include <iostream>
+
+#include <cstring>
+#include <string>
+
+#include "ecl/field/GFp.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::exp(Element *res, const Element &a, const Element &e) {
+  Element R;
+  int i, l;
+
+  l = e.count_bits();
+  if (l == 0) {
+    one(res);
+    return;
+  }
+
+  R.copy(a);
+
+  for (i = l - 1; i > 0; i--) {
+    sqr(&R, R);
+    if (e.get_bit(i - 1)) {
+      mul(&R, R, a);
+    }
+  }
+  res->copy(R);
+}
+
+/* Sliding window width for fixed exponents, 2^(EXP_WINDOW-1) odd powers */
+#define EXP_WINDOW 5
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::exp_setup(FixedExp *s, const Element &e) {
+  int i, j, k, zeros = 0;
+  int v;
+
+  s->len = 0;
+  i = e.count_bits() - 1;
+  while (i >= 0) {
+    if (!e.get_bit(i)) {
+      zeros++;
+      i--;
+      continue;
+    }
+    /* longest window e[i..j] ending with a 1 */
+    j = (i - EXP_WINDOW + 1 > 0) ? i - EXP_WINDOW + 1 : 0;
+    while (!e.get_bit(j)) {
+      j++;
+    }
+    v = 0;
+    for (k = i; k >= j; k--) {
+      v = (v << 1) | e.get_bit(k);
+    }
+    s->sqr[s->len] = (s->len == 0) ? 0 : zeros + i - j + 1;
+    s->idx[s->len] = v >> 1;
+    s->len++;
+    zeros = 0;
+    i = j - 1;
+  }
+  s->tail = zeros;
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::exp_fixed(Element *res, const Element &a,
+                               const FixedExp &s) {
+  Element T[1 << (EXP_WINDOW - 1)];  // a, a^3, ..., a^(2^EXP_WINDOW - 1)
+  Element R;
+  int i, j;
+
+  if (s.len == 0) {
+    one(res);
+    return;
+  }
+
+  T[0].copy(a);
+  sqr(&R, a);
+  for (i = 1; i < (1 << (EXP_WINDOW - 1)); i++) {
+    mul(&(T[i]), T[i - 1], R);
+  }
+
+  R.copy(T[s.idx[0]]);
+  for (i = 1; i < s.len; i++) {
+    for (j = 0; j < s.sqr[i]; j++) {
+      sqr(&R, R);
+    }
+    mul(&R, R, T[s.idx[i]]);
+  }
+  for (j = 0; j < s.tail; j++) {
+    sqr(&R, R);
+  }
+  res->copy(R);
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::init_exp() {
+  Element e;
+  ecl_word cur, rem = 0;
+  int i;
+
+  /* p is odd : (p-1)/2 = p >> 1 */
+  r_shift(&e, p_, 1);
+  exp_setup(&exp_pm1s2_, e);
+
+  if ((p_.val[0] & 0x03) == 3) {
+    r_shift(&e, p_, 2);  // (p-3)/4
+  } else if ((p_.val[0] & 0x07) == 5) {
+    r_shift(&e, p_, 3);  // (p-5)/8
+  } else {
+    e.zero();  // Tonelli-Shanks
+  }
+  exp_setup(&exp_sqrt_, e);
+
+  /* (p-1)/3, exact only if p = 1 mod 3 */
+  FixedSizedInt<nb_limbs>::sub(&e, p_, 1);
+  for (i = nb_limbs - 1; i >= 0; i--) {
+    cur = (rem << DIGIT_BITS) | e.val[i];
+    e.val[i] = (ecl_digit) (cur / 3);
+    rem = cur % 3;
+  }
+  exp_setup(&exp_pm1s3_, e);
+}
+
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::frobenius(Element *res, const Element &a, int i) {
+  res->copy(a);
+  return ERR_OK;
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_EXP_HPP_
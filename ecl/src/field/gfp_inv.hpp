@@ -0,0 +1,167 @@
+/**
+ * @file gfp_inv.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_INV_HPP_
+#define ECL_SRC_FIELD_GFP_INV_HPP_
+
+#include <iostream>
+
+#include <cstring>
+#include <string>
+
+#include "ecl/field/GFp.h"
+#include "inv_batch.hpp"
+#include "safegcd.hpp"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::r_shift(Element *res, const Element &a) {
+  return FixedSizedInt<nb_limbs>::r_shift(res, a, 1);
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::r_shift(Element *res, const Element &a, int d) {
+  return FixedSizedInt<nb_limbs>::r_shift(res, a, d);
+}
+
+
+#ifdef DIGIT_64
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv(Element *res, const Element &a) {
+  safegcd::modinfo mi;
+  safegcd::signed62 x;
+
+  if (nb_limbs != 4) {
+    /* safegcd is for 256 bits : Fermat, a^(p-2), the exponent is public */
+    Element e;
+    Element::sub(&e, p_, 2);
+    exp(res, a, e);
+    return;
+  }
+  /* Bernstein-Yang divsteps, fixed number of iterations */
+  safegcd::setup(&mi, p_.val, m_);
+  safegcd::from_digits(&x, a.val);
+  safegcd::modinv(&x, mi);
+  safegcd::to_digits(res->val, x);
+  ZEROMEM(&x, sizeof(x));
+  /* res = (aR)^-1 -> MonPro(res, R^3) = a^-1.R */
+  this->mul(res, *res, R3_);
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv_vartime(Element *res, const Element &a) {
+  safegcd::modinfo mi;
+  safegcd::signed62 x;
+
+  if (nb_limbs != 4) {
+    inv(res, a);
+    return;
+  }
+  safegcd::setup(&mi, p_.val, m_);
+  safegcd::from_digits(&x, a.val);
+  safegcd::modinv_var(&x, mi);
+  safegcd::to_digits(res->val, x);
+  this->mul(res, *res, R3_);
+}
+#else
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv(Element *res, const Element &a) {
+  Element r, s, u, v, T;
+  int k = 0;
+  unsigned char carry = 0;
+
+  /* Almost montgommery inverse computation */
+  /* u=p, v=a, r=0, s=1 */
+  u.copy(p_);
+  v.copy(a);
+  s.val[0] = 1;
+  while (!v.isZero()) {
+    /*  if u is even then u := u/2, s := 2s   */
+    if ((u.val[0] & 1) == 0) {
+      r_shift(&u, u);
+      FixedSizedInt<nb_limbs>::add(&s, s, s);
+    } else if ((v.val[0] & 1) == 0) {
+      /* else if v is even then v := v/2, r := 2r */
+      r_shift(&v, v);
+      carry = FixedSizedInt<nb_limbs>::add(&r, r, r);
+    } else if (this->cmp(u, v) == -1) {
+      /* else if u > v then u := (u − v)/2, r := r + s, s := 2s */
+      FixedSizedInt<nb_limbs>::sub(&u, u, v);
+      r_shift(&u, u);
+      carry = FixedSizedInt<nb_limbs>::add(&r, r, s);
+      FixedSizedInt<nb_limbs>::add(&s, s, s);
+    } else {
+      /* else (if v ≥ u then) v := (v − u)/2, s := s + r, r := 2r */
+      FixedSizedInt<nb_limbs>::sub(&v, v, u);
+      r_shift(&v, v);
+      FixedSizedInt<nb_limbs>::add(&s, r, s);
+      carry = FixedSizedInt<nb_limbs>::add(&r, r, r);
+    }
+    /* k := k + 1  */
+    k++;
+  }
+
+  if (carry || (cmp(r, p_) == -1)) {
+    FixedSizedInt<nb_limbs>::sub(&r, r, p_);
+  }
+
+  FixedSizedInt<nb_limbs>::sub(&r, p_, r);
+
+  /* Here r = a^-1 . 2^−m .2^k */
+  /* Then phase 2 */
+  /* r := MonPro(r, R2) = (a^−1.2^−m.2^k )(2^2m)(2^−m ) = a^−1 . 2^k (mod p) */
+  this->mul(&r, r, R2_);
+  /* r := MonPro(r, 2^(2m−k)) = (a^−1.2^k )(2^(2m−k) )(2^(−m) ) = a^−1.2^m (mod p) */
+
+  // calculate 2^(2m-k) mod p
+  // k is between 256 and 512 -> 2m-k is between 0 and 256...
+  // 2^(2m-k) mod p = 2^(2m-k) ...
+  if ((k != 2 * nb_limbs * DIGIT_BITS) && (k != 0)) {  // in this case multiply by R_ => useless !!
+    T.val[(2 * nb_limbs * DIGIT_BITS - k) / DIGIT_BITS] = ((ecl_digit) 1)
+        << ((2 * nb_limbs * DIGIT_BITS - k) % DIGIT_BITS);
+    this->mul(&r, r, T);
+  }
+
+  res->copy(r);
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv_vartime(Element *res, const Element &a) {
+  inv(res, a);
+}
+#endif
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n) {
+  simultaneous_inv(this, res, a, n, res);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::inv_batch(Element *res, const Element *a, size_t n,
+                               Element *scratch) {
+  simultaneous_inv(this, res, a, n, scratch);
+}
+
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::div(Element *res, const Element &a, const Element &b) {
+  Element tmp;
+  inv(&tmp, b);
+  mul(res, tmp, a);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_INV_HPP_
@@ -0,0 +1,151 @@
+/**
+ * @file gfp_mul.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_MUL_HPP_
+#define ECL_SRC_FIELD_GFP_MUL_HPP_
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+
+#include "ecl/field/GFp.h"
+
+#include "../asm/arch.h"
+#include "comba.hpp"
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::mul(Double *res, const Element &a, const Element &b) {
+#ifdef ARCH_X86_64
+  if (use_mulx_) {
+    mulx_mul_4(res->val, a.val, b.val);
+    return;
+  }
+#endif
+  comba::mul<nb_limbs>(res->val, a.val, b.val);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sqr(Double *res, const Element &a) {
+#ifdef ARCH_X86_64
+  if (use_mulx_) {
+    mulx_sqr_4(res->val, a.val);
+    return;
+  }
+#endif
+  comba::sqr<nb_limbs>(res->val, a.val);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::mul(Element *res, const Element &a, const Element &b) {
+#ifdef ARCH_X86_64
+  if (use_mulx_) {
+    if (p256_) {
+      mulx_p256_montmul_4(res->val, a.val, b.val, p_.val);
+    } else {
+      mulx_montmul_4(res->val, a.val, b.val, p_.val, m_);
+    }
+    return;
+  }
+#endif
+  Double tmp;
+  mul(&tmp, a, b);
+  reduce(res, tmp);
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::mul(Element *res, const Element &a, const ecl_digit b) {
+  Element tmp;
+  switch (b) {
+    case 1:
+      res->copy(a);
+      break;
+    case 2:
+      add(res, a, a);
+      break;
+    case 3:
+      add(&tmp, a, a);
+      add(res, a, tmp);
+      break;
+    case 4:
+      add(res, a, a);
+      add(res, *res, *res);
+      break;
+    case 5:
+      add(&tmp, a, a);
+      add(&tmp, tmp, tmp);
+      add(res, a, tmp);
+      break;
+    case 8:
+      add(res, a, a);
+      add(res, *res, *res);
+      add(res, *res, *res);
+      break;
+    default:
+      set(&tmp, b);
+      mul(res, tmp, a);
+      break;
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::mul(Double *res, const Double &a, const ecl_digit b) {
+  Double tmp;
+  switch (b) {
+    case 1:
+      res->copy(a);
+      break;
+    case 2:
+      add(res, a, a);
+      break;
+    case 3:
+      add(&tmp, a, a);
+      add(res, a, tmp);
+      break;
+    case 4:
+      add(res, a, a);
+      add(res, *res, *res);
+      break;
+    case 5:
+      add(&tmp, a, a);
+      add(&tmp, tmp, tmp);
+      add(res, a, tmp);
+      break;
+    case 8:
+      add(res, a, a);
+      add(res, *res, *res);
+      add(res, *res, *res);
+      break;
+    default:
+      // unsupported
+      break;
+  }
+}
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::sqr(Element *res, const Element &a) {
+#ifdef ARCH_X86_64
+  if (use_mulx_) {
+    ecl_digit tmp[2 * nb_limbs];
+    mulx_sqr_4(tmp, a.val);
+    if (p256_) {
+      mulx_p256_reduce_4(res->val, tmp, p_.val);
+    } else {
+      mulx_reduce_4(res->val, tmp, p_.val, m_);
+    }
+    return;
+  }
+#endif
+  Double tmp;
+  sqr(&tmp, a) ;
+  reduce(res, tmp);
+}
+
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_MUL_HPP_
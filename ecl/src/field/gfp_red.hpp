@@ -0,0 +1,126 @@
+/**
+ * @file gfp_red.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_RED_HPP_
+#define ECL_SRC_FIELD_GFP_RED_HPP_
+
+#include <cassert>
+#include <cstring>
+
+#include "ecl/errcode.h"
+#include "ecl/field/GFp.h"
+#include "../asm/arch.h"
+#include "comba.hpp"
+#include "montgomery.hpp"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::montSetup(ecl_digit *rho, const Element &a) {
+  if ((a.val[0] & 1) == 0) {
+    return ERR_INVALID_VALUE;
+  }
+  *rho = montgomery::neg_inv(a.val[0]);
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+bool GFpN<nb_limbs>::isP256(const Element &p) {
+#ifdef DIGIT_64
+  return nb_limbs == 4 && p.val[0] == 0xffffffffffffffffULL
+      && p.val[1] == 0x00000000ffffffffULL && p.val[2] == 0
+      && p.val[3] == 0xffffffff00000001ULL;
+#else
+  (void) p;
+  return false;
+#endif
+}
+
+#ifdef DIGIT_64
+/* Montgomery reduction modulo p = 2^256 - 2^224 + 2^192 + 2^96 - 1.
+ *
+ * p = -1 mod 2^64 so m' = -1/p = 1 : the quotient digit is the current
+ * digit t0 itself. Moreover, with p[0] = 2^64 - 1, p[1] = 2^32 - 1 and
+ * p[2] = 0 :
+ *   t0 + t0.p[0]        = t0.2^64
+ *   t1 + t0.p[1] + t0   = t1 + t0.2^32
+ * so each step costs a single multiplication (by p[3]) instead of four.
+ * The lower half is reduced first, (alow + M.p) / 2^256 <= p, then the
+ * upper half is added.
+ */
+template<int nb_limbs>
+void GFpN<nb_limbs>::p256_reduce(Element *res, const ecl_digit *a) {
+  ecl_digit t0, t1, t2, t3, m, c;
+  ecl_word w;
+  int i;
+
+  t0 = a[0];
+  t1 = a[1];
+  t2 = a[2];
+  t3 = a[3];
+  for (i = 0; i < 4; i++) {
+    m = t0;
+    w = (ecl_word) t1 + (m << 32);
+    t0 = (ecl_digit) w;
+    w = (ecl_word) t2 + (m >> 32) + (ecl_digit) (w >> DIGIT_BITS);
+    t1 = (ecl_digit) w;
+    w = (ecl_word) m * p_.val[3] + t3 + (ecl_digit) (w >> DIGIT_BITS);
+    t2 = (ecl_digit) w;
+    t3 = (ecl_digit) (w >> DIGIT_BITS);
+  }
+
+  w = (ecl_word) t0 + a[4];
+  res->val[0] = (ecl_digit) w;
+  w = (ecl_word) t1 + a[5] + (ecl_digit) (w >> DIGIT_BITS);
+  res->val[1] = (ecl_digit) w;
+  w = (ecl_word) t2 + a[6] + (ecl_digit) (w >> DIGIT_BITS);
+  res->val[2] = (ecl_digit) w;
+  w = (ecl_word) t3 + a[7] + (ecl_digit) (w >> DIGIT_BITS);
+  res->val[3] = (ecl_digit) w;
+  c = (ecl_digit) (w >> DIGIT_BITS);
+
+  /* if res >= p then res = res -p */
+  if (c || (cmp(*res, p_) != 1)) {
+    FixedSizedInt<nb_limbs>::sub(res, *res, p_);
+  }
+}
+#else
+template<int nb_limbs>
+void GFpN<nb_limbs>::p256_reduce(Element *res, const ecl_digit *a) {
+  Double t;
+  memcpy(t.val, a, sizeof(t.val));
+  reduce(res, t);
+}
+#endif
+
+template<int nb_limbs>
+void GFpN<nb_limbs>::reduce(Element *res, const Double &a) {
+  /* a <= p.R, otherwise the result is not reduced : catches lazy operands
+   * out of bound, see add_lazy() */
+  assert(cmp_p(a) != -1);
+#ifdef ARCH_X86_64
+  if (use_mulx_) {
+    if (p256_) {
+      mulx_p256_reduce_4(res->val, a.val, p_.val);
+    } else {
+      mulx_reduce_4(res->val, a.val, p_.val, m_);
+    }
+    return;
+  }
+#endif
+  if (p256_) {
+    p256_reduce(res, a.val);
+    return;
+  }
+  comba::reduce<nb_limbs>(res->val, a.val, p_.val, m_);
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_RED_HPP_
@@ -0,0 +1,316 @@
+/**
+ * @file gfp_sqrt.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_GFP_SQRT_HPP_
+#define ECL_SRC_FIELD_GFP_SQRT_HPP_
+
+#include <cstring>
+
+#include "ecl/field/GFp.h"
+#include "../asm/arch.h"
+
+using ecl::ErrCode;
+
+namespace ecl {
+namespace field {
+
+#ifdef DIGIT_64
+/* Computes r = |a.f + b.g| / 2^29, a.f + b.g being a multiple of 2^29.
+ * Returns all ones if a.f + b.g < 0, 0 otherwise.
+ */
+template<int N>
+static uint64_t lin_div29_abs(ecl_digit *r, const ecl_digit *a,
+                              const ecl_digit *b, int64_t f, int64_t g) {
+  ecl_digit d[N + 1];
+  __int128 cc = 0;
+  uint64_t neg, carry, w;
+  int i;
+
+  for (i = 0; i < N; i++) {
+    cc += (__int128) a[i] * f + (__int128) b[i] * g;
+    d[i] = (ecl_digit) cc;
+    cc >>= DIGIT_BITS;
+  }
+  d[N] = (ecl_digit) cc;
+
+  /* conditional negation */
+  neg = (uint64_t) ((int64_t) d[N] >> 63);
+  carry = neg & 1;
+  for (i = 0; i <= N; i++) {
+    w = (d[i] ^ neg) + carry;
+    carry = (w < carry);
+    d[i] = w;
+  }
+  for (i = 0; i < N; i++) {
+    r[i] = (d[i] >> 29) | (d[i + 1] << (DIGIT_BITS - 29));
+  }
+  return neg;
+}
+
+/* Legendre symbol by binary GCD (T. Pornin, "Optimized Binary GCD for Modular
+ * Inversion"), in constant time.
+ * Inner loops work on 64 bits approximations (33 top bits, 31 low bits) and
+ * keep track of the symbol with the low bits, which are exact :
+ *  - swapping a and b flips it if a = b = 3 mod 4,
+ *  - halving a flips it if b = 3 or 5 mod 8.
+ * Each outer iteration lowers len(a) + len(b) by at least 28, 19 iterations
+ * are enough for 256 bits inputs, 28 for 384 bits ones.
+ */
+template<int nb_limbs>
+int GFpN<nb_limbs>::legendre(const Element &a) {
+  ecl_digit u[nb_limbs], v[nb_limbs], nu[nb_limbs], nv[nb_limbs];
+  uint64_t xa, xb, a_hi, a_lo, b_hi, b_lo, c_hi, c_lo, m, mw;
+  uint64_t fg0, fg1, a_odd, swap, t, ls = 0;
+  int64_t f0, g0, f1, g1;
+  int i, j, s;
+
+  /* aR and a have the same symbol, R being an even power of 2 */
+  memcpy(u, a.val, sizeof(u));
+  memcpy(v, p_.val, sizeof(v));
+
+  for (i = 0; i < (2 * nb_limbs * DIGIT_BITS + 27) / 28; i++) {
+    /* a_hi, b_hi : top non zero word of u|v, a_lo, b_lo : the word below */
+    c_hi = (uint64_t) -1;
+    c_lo = (uint64_t) -1;
+    a_hi = a_lo = b_hi = b_lo = 0;
+    for (j = nb_limbs - 1; j >= 0; j--) {
+      a_hi ^= (a_hi ^ u[j]) & c_hi;
+      a_lo ^= (a_lo ^ u[j]) & c_lo;
+      b_hi ^= (b_hi ^ v[j]) & c_hi;
+      b_lo ^= (b_lo ^ v[j]) & c_lo;
+      c_lo = c_hi;
+      mw = u[j] | v[j];
+      c_hi &= ((mw | (0 - mw)) >> 63) - 1;
+    }
+    /* v is odd : a_hi | b_hi != 0 */
+    s = __builtin_clzll(a_hi | b_hi);
+    xa = (a_hi << s) | ((a_lo >> 1) >> (63 - s));
+    xb = (b_hi << s) | ((b_lo >> 1) >> (63 - s));
+    xa = (xa & 0xFFFFFFFF80000000ULL) | (u[0] & 0x7FFFFFFFULL);
+    xb = (xb & 0xFFFFFFFF80000000ULL) | (v[0] & 0x7FFFFFFFULL);
+    /* exact values if they fit in 64 bits */
+    m = 0;
+    for (j = 1; j < nb_limbs; j++) {
+      m |= u[j] | v[j];
+    }
+    m = ((m | (0 - m)) >> 63) - 1;
+    xa ^= m & (xa ^ u[0]);
+    xb ^= m & (xb ^ v[0]);
+
+    /* update factors packed as f + 2^32.g */
+    fg0 = 1;
+    fg1 = (uint64_t) 1 << 32;
+    for (j = 0; j < 29; j++) {
+      a_odd = 0 - (xa & 1);
+      swap = a_odd & (0 - (uint64_t) (xa < xb));
+      ls ^= swap & ((xa & xb) >> 1);
+      t = swap & (xa ^ xb);
+      xa ^= t;
+      xb ^= t;
+      t = swap & (fg0 ^ fg1);
+      fg0 ^= t;
+      fg1 ^= t;
+      xa -= a_odd & xb;
+      fg0 -= a_odd & fg1;
+      xa >>= 1;
+      fg1 <<= 1;
+      ls ^= (xb + 2) >> 2;
+    }
+    /* |f|, |g| <= 2^29 */
+    fg0 += 0x7FFFFFFF7FFFFFFFULL;
+    fg1 += 0x7FFFFFFF7FFFFFFFULL;
+    f0 = (int64_t) (fg0 & 0xFFFFFFFF) - 0x7FFFFFFF;
+    g0 = (int64_t) (fg0 >> 32) - 0x7FFFFFFF;
+    f1 = (int64_t) (fg1 & 0xFFFFFFFF) - 0x7FFFFFFF;
+    g1 = (int64_t) (fg1 >> 32) - 0x7FFFFFFF;
+
+    t = lin_div29_abs<nb_limbs>(nu, u, v, f0, g0);
+    lin_div29_abs<nb_limbs>(nv, u, v, f1, g1);
+    /* (-u|v) = (-1|v).(u|v) */
+    ls ^= t & (nv[0] >> 1);
+    memcpy(u, nu, sizeof(u));
+    memcpy(v, nv, sizeof(v));
+  }
+
+  if (a.isZero()) {
+    return 0;
+  }
+  return 1 - (int) ((ls & 1) << 1);
+}
+#else
+template<int nb_limbs>
+int GFpN<nb_limbs>::legendre(const Element &a) {
+  Element tmp;
+  int ret;
+
+  if (a.isZero()) {
+    return 0;
+  }
+
+  exp_fixed(&tmp, a, exp_pm1s2_);
+
+  if (isOne(tmp)) {
+    ret = 1;
+  } else {
+    ret = -1;
+  }
+
+  return ret;
+}
+#endif
+
+// implementation following
+// http://math.univ-lyon1.fr/homes-www/roblot/resources/ens_partie_3.pdf
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::tonelli_shanks(Element *res, const Element &a) {
+  ErrCode ret = ERR_OK;
+  //int carry;
+  Element tmp, tmp1, tmp2, e1, e2, pm1, pm1s2;
+  Element aa, tres, m1;
+  Element g, one_e, q;
+
+  // g such that g is a quadratic non residue mod p
+  g.set(7);
+  one_e.set(1);
+  set(&m1, -1);
+
+  do {
+    add(&g, g, one_e);
+  } while (legendre(g) != -1);
+
+  FixedSizedInt<nb_limbs>::sub(&pm1, p_, 1);
+  r_shift(&pm1s2, pm1);
+
+  e1.copy(pm1s2);  // e1 = (p-1)/2
+  e2.zero();  // e2 = 0 ;
+
+  exp(&aa, g, pm1s2);
+
+  aa.copy(a);
+
+  while ((e1.val[0] & 0x01) == 0) {  // e1 even
+    r_shift(&e1, e1);
+    r_shift(&e2, e2);
+    exp(&tmp1, aa, e1);
+    exp(&tmp2, g, e2);
+    mul(&tmp, tmp1, tmp2);
+
+    // if a^e1 . g^e2 = -1 mod p
+    if (tmp.eq(m1)) {
+      // e2 = e2 + (p-1)/2
+      FixedSizedInt<nb_limbs>::add(&e2, pm1s2, e2);
+    }
+  }
+
+  // return a^(e1+1)/2 g^e2/2 mod p
+  add(&tmp, e1, 1);
+  r_shift(&tmp, tmp);
+  exp(&tmp1, aa, tmp);
+  r_shift(&e2, e2);
+  exp(&tmp2, g, e2);
+  mul(res, tmp1, tmp2);
+
+  return ret;
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::sqrt(Element *res, const Element &a) {
+  Element x, t, b;
+
+  if ((p_.val[0] & 0x03) == 3) {
+    // x = a^((p+1)/4) = a.a^((p-3)/4)
+    exp_fixed(&t, a, exp_sqrt_);
+    mul(&x, t, a);
+  } else if ((p_.val[0] & 0x07) == 5) {
+    // Atkin : b = (2a)^((p-5)/8), i = 2a.b^2, x = a.b.(i-1)
+    add(&t, a, a);
+    exp_fixed(&b, t, exp_sqrt_);
+    mul(&x, a, b);
+    sqr(&b, b);
+    mul(&t, t, b);
+    sub(&t, t, R_);
+    mul(&x, x, t);
+  } else {
+    if (legendre(a) != 1) {
+      return ERR_NOT_SQUARE;
+    }
+    return tonelli_shanks(res, a);
+  }
+
+  // no residuosity test beforehand : check the candidate instead
+  sqr(&t, x);
+  if (cmp(t, a) != 0) {
+    return ERR_NOT_SQUARE;
+  }
+  res->copy(x);
+
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::sqrt_ratio(Element *res, const Element &u,
+                                   const Element &v) {
+  ErrCode rv;
+  Element x, t, uv;
+
+  if (v.isZero()) {
+    return ERR_INVALID_VALUE;
+  }
+
+  if ((p_.val[0] & 0x03) != 3) {
+    inv(&t, v);
+    mul(&t, t, u);
+    rv = sqrt(&x, t);
+    if (rv == ERR_OK) {
+      res->copy(x);
+    }
+    return rv;
+  }
+
+  // x = u.v.(u.v^3)^((p-3)/4)
+  mul(&uv, u, v);
+  sqr(&t, v);
+  mul(&t, t, uv);
+  exp_fixed(&t, t, exp_sqrt_);
+  mul(&x, t, uv);
+
+  // x^2 = (u/v).legendre(u.v)
+  sqr(&t, x);
+  mul(&t, t, v);
+  if (cmp(t, u) != 0) {
+    return ERR_NOT_SQUARE;
+  }
+  res->copy(x);
+
+  return ERR_OK;
+}
+
+template<int nb_limbs>
+ErrCode GFpN<nb_limbs>::inv_sqrt(Element *res, const Element &a) {
+  Element o;
+
+  one(&o);
+  return sqrt_ratio(res, o, a);
+}
+
+template<int nb_limbs>
+bool GFpN<nb_limbs>::isQNR(const Element &a) {
+  return (legendre(a) != 1);
+}
+
+template<int nb_limbs>
+bool GFpN<nb_limbs>::isCNR(const Element &a) {
+  Element res;
+
+  // only right if p == 1 mod 3
+  exp_fixed(&res, a, exp_pm1s3_);
+
+  return !isOne(res);  // CNR only if a^(p-1)/3 != 1 mod p
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_GFP_SQRT_HPP_
@@ -0,0 +1,81 @@
+/**
+ * @file inv_batch.hpp
+ * @author Julien Kowalski
+ */
+
+#ifndef ECL_SRC_FIELD_INV_BATCH_HPP_
+#define ECL_SRC_FIELD_INV_BATCH_HPP_
+
+#include <cstddef>
+
+#include "ecl/config.h"
+
+namespace ecl {
+namespace field {
+
+/** Simultaneous inversion of n elements (Montgomery's trick).
+ * Costs one inversion and 3(n-1) multiplications.
+ * Zero elements are left out of the product and mapped to zero.
+ * The products a[0] * ... * a[i] are kept in acc, which is either res, when
+ * res does not overlap a, or a scratch of n elements wiped on return.
+ * @param[in] f field
+ * @param[out] res results
+ * @param[in] a operands
+ * @param[in] n number of elements
+ * @param[in] acc res or a scratch of n elements
+ */
+template<class Field>
+void simultaneous_inv(Field *f, typename Field::Element *res,
+                      const typename Field::Element *a, size_t n,
+                      typename Field::Element *acc) {
+  typedef typename Field::Element Element;
+  Element t, u;
+  size_t i;
+
+  if (n == 0) {
+    return;
+  }
+
+  /* acc[i] = a[0] * ... * a[i] */
+  if (f->isZero(a[0])) {
+    f->one(&(acc[0]));
+  } else {
+    f->copy(&(acc[0]), a[0]);
+  }
+  for (i = 1; i < n; i++) {
+    if (f->isZero(a[i])) {
+      f->copy(&(acc[i]), acc[i - 1]);
+    } else {
+      f->mul(&(acc[i]), acc[i - 1], a[i]);
+    }
+  }
+
+  /* t = 1 / (a[0] * ... * a[i]), acc[i] is no longer needed once res[i] is
+   * written */
+  f->inv(&t, acc[n - 1]);
+  for (i = n - 1; i > 0; i--) {
+    if (f->isZero(a[i])) {
+      f->zero(&(res[i]));
+      continue;
+    }
+    f->mul(&u, t, acc[i - 1]);
+    f->mul(&t, t, a[i]);
+    f->copy(&(res[i]), u);
+  }
+  if (f->isZero(a[0])) {
+    f->zero(&(res[0]));
+  } else {
+    f->copy(&(res[0]), t);
+  }
+
+  if (acc != res) {
+    ZEROMEM(acc, n * sizeof(Element));
+  }
+  ZEROMEM(&t, sizeof(t));
+  ZEROMEM(&u, sizeof(u));
+}
+
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_INV_BATCH_HPP_
@@ -0,0 +1,86 @@
+/**
+ * @file montgomery.hpp
+ * @author Julien Kowalski
+ *
+ * Montgomery constants of the runtime prime fields (GFpN).
+ * StaticGFp computes the same constants at compile time.
+ */
+
+#ifndef ECL_SRC_FIELD_MONTGOMERY_HPP_
+#define ECL_SRC_FIELD_MONTGOMERY_HPP_
+
+#include "ecl/config.h"
+#include "ecl/bigint/FixedSizedInt.h"
+#include "comba.hpp"
+
+namespace ecl {
+namespace field {
+namespace montgomery {
+
+/** Computes -1/b mod 2^DIGIT_BITS.
+ * Fast inversion mod 2**k, based on the fact that
+ *
+ * XA = 1 (mod 2**n)  =>  (X(2-XA)) A = 1 (mod 2**2n)
+ *                    =>  2*X*A - X*X*A*A = 1
+ *                    =>  2*(1) - (1)     = 1
+ * @param[in] b odd digit
+ * @return -1/b mod 2^DIGIT_BITS
+ */
+static inline ecl_digit neg_inv(ecl_digit b) {
+  ecl_digit x;
+
+  x = (((b + 2) & 4) << 1) + b; /* here x*a==1 mod 2**4 */
+  x *= 2 - b * x; /* here x*a==1 mod 2**8 */
+  x *= 2 - b * x; /* here x*a==1 mod 2**16 */
+  x *= 2 - b * x; /* here x*a==1 mod 2**32 */
+#ifdef DIGIT_64
+  x *= 2 - b * x; /* here x*a==1 mod 2**64 */
+#endif
+  return 0 - x;
+}
+
+/* r = 2r mod p, r < p */
+template<int N>
+static inline void double_mod(FixedSizedInt<N> *r, const FixedSizedInt<N> &p) {
+  ecl_digit carry;
+
+  carry = FixedSizedInt<N>::add(r, *r, *r);
+  comba::final_sub<N>(r->val, carry, p.val);
+}
+
+/** Computes R, R^2 and R^3 mod p, with R = 2^(N*DIGIT_BITS), by doublings
+ * of the highest power of 2 lower than p.
+ * @param[out] R R mod p
+ * @param[out] R2 R^2 mod p
+ * @param[out] R3 R^3 mod p
+ * @param[in] p odd modulus
+ */
+template<int N>
+static inline void powers_of_R(FixedSizedInt<N> *R, FixedSizedInt<N> *R2,
+                               FixedSizedInt<N> *R3,
+                               const FixedSizedInt<N> &p) {
+  int i, bits;
+
+  bits = p.count_bits() - 1;
+  R->zero();
+  R->val[bits / DIGIT_BITS] = ((ecl_digit) 1) << (bits % DIGIT_BITS);
+  for (i = bits; i < N * DIGIT_BITS; i++) {
+    double_mod(R, p);
+  }
+
+  R2->copy(*R);
+  for (i = 0; i < N * DIGIT_BITS; i++) {
+    double_mod(R2, p);
+  }
+
+  R3->copy(*R2);
+  for (i = 0; i < N * DIGIT_BITS; i++) {
+    double_mod(R3, p);
+  }
+}
+
+}  // namespace montgomery
+}  // namespace field
+}  // namespace ecl
+
+#endif  // ECL_SRC_FIELD_MONTGOMERY_HPP_
@@ -0,0 +1,330 @@
+/**
+ * @file safegcd.hpp
+ * @author Julien Kowalski
+ *
+ * Modular inversion by divsteps (Bernstein-Yang safegcd), on numbers of up
+ * to 256 bits represented with 5 signed limbs of 62 bits.
+ * Only available for 64 bits digits.
+ */
+
+#ifndef ECL_SRC_FIELD_SAFEGCD_HPP_
+#define ECL_SRC_FIELD_SAFEGCD_HPP_
+
+#include "ecl/config.h"
+
+#ifdef DIGIT_64
+
+namespace ecl {
+namespace field {
+namespace safegcd {
+
+typedef __int128 int128_t;
+
+static const uint64_t M62 = UINT64_MAX >> 2;
+
+/** Number in radix 2^62, limbs in [0, 2^62[ except the last one which is
+ * signed. */
+struct signed62 {
+  int64_t v[5];
+};
+
+/** Modulus information. */
+struct modinfo {
+  signed62 modulus;  //!< odd modulus
+  uint64_t modulus_inv62;  //!< modulus^-1 mod 2^62
+};
+
+/** Transition matrix of 62 divsteps, scaled by 2^62. */
+struct trans2x2 {
+  int64_t u, v, q, r;
+};
+
+/** Converts 4 limbs of 64 bits to radix 2^62. */
+static inline void from_digits(signed62 *r, const ecl_digit *a) {
+  r->v[0] = (int64_t) (a[0] & M62);
+  r->v[1] = (int64_t) ((a[0] >> 62 | a[1] << 2) & M62);
+  r->v[2] = (int64_t) ((a[1] >> 60 | a[2] << 4) & M62);
+  r->v[3] = (int64_t) ((a[2] >> 58 | a[3] << 6) & M62);
+  r->v[4] = (int64_t) (a[3] >> 56);
+}
+
+/** Converts a normalized radix 2^62 number to 4 limbs of 64 bits. */
+static inline void to_digits(ecl_digit *r, const signed62 &a) {
+  const uint64_t a0 = a.v[0], a1 = a.v[1], a2 = a.v[2], a3 = a.v[3],
+      a4 = a.v[4];
+  r[0] = a0 | a1 << 62;
+  r[1] = a1 >> 2 | a2 << 60;
+  r[2] = a2 >> 4 | a3 << 58;
+  r[3] = a3 >> 6 | a4 << 56;
+}
+
+/** Sets up modulus information from an odd modulus of 4 limbs and the
+ * Montgomery constant m = -1/p mod 2^64.
+ */
+static inline void setup(modinfo *mi, const ecl_digit *p, ecl_digit m) {
+  from_digits(&(mi->modulus), p);
+  mi->modulus_inv62 = (0 - m) & M62;
+}
+
+/** Performs 59 divsteps in constant time.
+ * zeta = -(delta + 1/2), matrix is scaled by 2^62.
+ */
+static inline int64_t divsteps_59(int64_t zeta, uint64_t f0, uint64_t g0,
+                                  trans2x2 *t) {
+  uint64_t u = 8, v = 0, q = 0, r = 8;
+  volatile uint64_t c1, c2;
+  uint64_t mask1, mask2, f = f0, g = g0, x, y, z;
+  int i;
+
+  for (i = 3; i < 62; i++) {
+    c1 = zeta >> 63;
+    mask1 = c1;
+    c2 = g & 1;
+    mask2 = 0 - c2;
+    // conditionally negate f, u, v if zeta < 0
+    x = (f ^ mask1) - mask1;
+    y = (u ^ mask1) - mask1;
+    z = (v ^ mask1) - mask1;
+    // conditionally add to g, q, r if g is odd
+    g += x & mask2;
+    q += y & mask2;
+    r += z & mask2;
+    // swap if zeta < 0 and g odd
+    mask1 &= mask2;
+    zeta = (zeta ^ (int64_t) mask1) - 1;
+    f += g & mask1;
+    u += q & mask1;
+    v += r & mask1;
+    g >>= 1;
+    u <<= 1;
+    v <<= 1;
+  }
+  t->u = (int64_t) u;
+  t->v = (int64_t) v;
+  t->q = (int64_t) q;
+  t->r = (int64_t) r;
+  return zeta;
+}
+
+/** Performs up to 62 divsteps in variable time.
+ * eta = -delta, matrix is scaled by 2^62.
+ */
+static inline int64_t divsteps_62_var(int64_t eta, uint64_t f0, uint64_t g0,
+                                      trans2x2 *t) {
+  uint64_t u = 1, v = 0, q = 0, r = 1;
+  uint64_t f = f0, g = g0, m, w, tmp;
+  int i = 62, limit, zeros;
+
+  for (;;) {
+    // remove trailing zeros of g, at most i
+    zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+    g >>= zeros;
+    u <<= zeros;
+    v <<= zeros;
+    eta -= zeros;
+    i -= zeros;
+    if (i == 0) {
+      break;
+    }
+    if (eta < 0) {
+      eta = -eta;
+      tmp = f;
+      f = g;
+      g = 0 - tmp;
+      tmp = u;
+      u = q;
+      q = 0 - tmp;
+      tmp = v;
+      v = r;
+      r = 0 - tmp;
+      // cancel up to 6 bits of g
+      limit = ((int) eta + 1) > i ? i : ((int) eta + 1);
+      m = (UINT64_MAX >> (64 - limit)) & 63U;
+      w = (f * g * (f * f - 2)) & m;
+    } else {
+      // cancel up to 4 bits of g
+      limit = ((int) eta + 1) > i ? i : ((int) eta + 1);
+      m = (UINT64_MAX >> (64 - limit)) & 15U;
+      w = f + (((f + 1) & 4) << 1);
+      w = (0 - w * g) & m;
+    }
+    g += f * w;
+    q += u * w;
+    r += v * w;
+  }
+  t->u = (int64_t) u;
+  t->v = (int64_t) v;
+  t->q = (int64_t) q;
+  t->r = (int64_t) r;
+  return eta;
+}
+
+/** Computes (t/2^62) [d, e] mod modulus.
+ * d and e in ]-2.modulus, modulus[ on input and output.
+ */
+static inline void update_de_62(signed62 *d, signed62 *e, const trans2x2 &t,
+                                const modinfo &mi) {
+  const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+  int64_t md, me, sd, se;
+  int128_t cd, ce;
+  int i;
+
+  // add modulus to make the result positive
+  sd = d->v[4] >> 63;
+  se = e->v[4] >> 63;
+  md = (u & sd) + (v & se);
+  me = (q & sd) + (r & se);
+  // limb 0, make bottom 62 bits zero
+  cd = (int128_t) u * d->v[0] + (int128_t) v * e->v[0];
+  ce = (int128_t) q * d->v[0] + (int128_t) r * e->v[0];
+  md -= (mi.modulus_inv62 * (uint64_t) cd + md) & M62;
+  me -= (mi.modulus_inv62 * (uint64_t) ce + me) & M62;
+  cd += (int128_t) mi.modulus.v[0] * md;
+  ce += (int128_t) mi.modulus.v[0] * me;
+  cd >>= 62;
+  ce >>= 62;
+  for (i = 1; i < 5; i++) {
+    cd += (int128_t) u * d->v[i] + (int128_t) v * e->v[i];
+    ce += (int128_t) q * d->v[i] + (int128_t) r * e->v[i];
+    cd += (int128_t) mi.modulus.v[i] * md;
+    ce += (int128_t) mi.modulus.v[i] * me;
+    d->v[i - 1] = (int64_t) cd & M62;
+    cd >>= 62;
+    e->v[i - 1] = (int64_t) ce & M62;
+    ce >>= 62;
+  }
+  d->v[4] = (int64_t) cd;
+  e->v[4] = (int64_t) ce;
+}
+
+/** Computes (t/2^62) [f, g] on the len lowest limbs. */
+static inline void update_fg_62(int len, signed62 *f, signed62 *g,
+                                const trans2x2 &t) {
+  const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+  int128_t cf, cg;
+  int i;
+
+  cf = (int128_t) u * f->v[0] + (int128_t) v * g->v[0];
+  cg = (int128_t) q * f->v[0] + (int128_t) r * g->v[0];
+  cf >>= 62;
+  cg >>= 62;
+  for (i = 1; i < len; i++) {
+    cf += (int128_t) u * f->v[i] + (int128_t) v * g->v[i];
+    cg += (int128_t) q * f->v[i] + (int128_t) r * g->v[i];
+    f->v[i - 1] = (int64_t) cf & M62;
+    cf >>= 62;
+    g->v[i - 1] = (int64_t) cg & M62;
+    cg >>= 62;
+  }
+  f->v[len - 1] = (int64_t) cf;
+  g->v[len - 1] = (int64_t) cg;
+}
+
+/** Brings r from ]-2.modulus, modulus[ to [0, modulus[, negated if
+ * sign < 0. Constant time.
+ */
+static inline void normalize_62(signed62 *r, int64_t sign,
+                                const modinfo &mi) {
+  const int64_t m62 = (int64_t) M62;
+  volatile int64_t cond_add, cond_negate;
+  int i;
+
+  cond_add = r->v[4] >> 63;
+  for (i = 0; i < 5; i++) {
+    r->v[i] += mi.modulus.v[i] & cond_add;
+  }
+  cond_negate = sign >> 63;
+  for (i = 0; i < 5; i++) {
+    r->v[i] = (r->v[i] ^ cond_negate) - cond_negate;
+  }
+  for (i = 0; i < 4; i++) {
+    r->v[i + 1] += r->v[i] >> 62;
+    r->v[i] &= m62;
+  }
+  // r in ]-modulus, modulus[
+  cond_add = r->v[4] >> 63;
+  for (i = 0; i < 5; i++) {
+    r->v[i] += mi.modulus.v[i] & cond_add;
+  }
+  for (i = 0; i < 4; i++) {
+    r->v[i + 1] += r->v[i] >> 62;
+    r->v[i] &= m62;
+  }
+}
+
+/** Computes x = x^-1 mod modulus in constant time.
+ * x in [0, modulus[, 0 is mapped to 0.
+ */
+static inline void modinv(signed62 *x, const modinfo &mi) {
+  signed62 d = { { 0, 0, 0, 0, 0 } };
+  signed62 e = { { 1, 0, 0, 0, 0 } };
+  signed62 f = mi.modulus;
+  signed62 g = *x;
+  trans2x2 t;
+  int64_t zeta = -1;
+  int i;
+
+  // 10 * 59 = 590 divsteps are enough for 256 bits inputs
+  for (i = 0; i < 10; i++) {
+    zeta = divsteps_59(zeta, (uint64_t) f.v[0], (uint64_t) g.v[0], &t);
+    update_de_62(&d, &e, t, mi);
+    update_fg_62(5, &f, &g, t);
+  }
+  // g = 0, f = +/-1
+  normalize_62(&d, f.v[4], mi);
+  *x = d;
+
+  ZEROMEM(&d, sizeof(d));
+  ZEROMEM(&e, sizeof(e));
+  ZEROMEM(&f, sizeof(f));
+  ZEROMEM(&t, sizeof(t));
+}
+
+/** Computes x = x^-1 mod modulus in variable time.
+ * x in [0, modulus[, 0 is mapped to 0.
+ */
+static inline void modinv_var(signed62 *x, const modinfo &mi) {
+  signed62 d = { { 0, 0, 0, 0, 0 } };
+  signed62 e = { { 1, 0, 0, 0, 0 } };
+  signed62 f = mi.modulus;
+  signed62 g = *x;
+  trans2x2 t;
+  int64_t eta = -1, cond, fn, gn;
+  int j, len = 5;
+
+  for (;;) {
+    eta = divsteps_62_var(eta, (uint64_t) f.v[0], (uint64_t) g.v[0], &t);
+    update_de_62(&d, &e, t, mi);
+    update_fg_62(len, &f, &g, t);
+    // stop when g = 0
+    if (g.v[0] == 0) {
+      cond = 0;
+      for (j = 1; j < len; j++) {
+        cond |= g.v[j];
+      }
+      if (cond == 0) {
+        break;
+      }
+    }
+    // shorten f and g when their top limbs are sign extension only
+    fn = f.v[len - 1];
+    gn = g.v[len - 1];
+    cond = ((int64_t) len - 2) >> 63;
+    cond |= fn ^ (fn >> 63);
+    cond |= gn ^ (gn >> 63);
+    if (cond == 0) {
+      f.v[len - 2] |= (uint64_t) fn << 62;
+      g.v[len - 2] |= (uint64_t) gn << 62;
+      len--;
+    }
+  }
+  normalize_62(&d, f.v[len - 1], mi);
+  *x = d;
+}
+
+}  // namespace safegcd
+}  // namespace field
+}  // namespace ecl
+
+#endif  // DIGIT_64
+#endif  // ECL_SRC_FIELD_SAFEGCD_HPP_
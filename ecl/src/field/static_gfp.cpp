@@ -0,0 +1,33 @@
+/**
+ * @file static_gfp.cpp
+ * @author Julien Kowalski
+ */
+
+#include "StaticGFp.hpp"
+
+namespace ecl {
+namespace field {
+
+#if defined(ARCH_X86_64)
+void static_gfp_mulx_montmul(ecl_digit *res, const ecl_digit *a,
+                             const ecl_digit *b, const ecl_digit *p,
+                             ecl_digit m) {
+  mulx_montmul_4(res, a, b, p, m);
+}
+
+void static_gfp_mulx_sqr(ecl_digit *res, const ecl_digit *a,
+                         const ecl_digit *p, ecl_digit m) {
+  ecl_digit tmp[2 * NB_LIMBS];
+
+  mulx_sqr_4(tmp, a);
+  mulx_reduce_4(res, tmp, p, m);
+}
+#endif
+
+template class StaticGFp<Beuchat254Prime> ;
+template class StaticGFp<Aranha254Prime> ;
+template class StaticGFp<Naering256Prime> ;
+template class StaticGFp<P256Prime> ;
+
+}  // namespace field
+}  // namespace ecl
@@ -0,0 +1,244 @@
+/**
+ * FixedSizedInt_test.cc
+ *
+ * Part of the eclv2 library.
+ *
+ * Copyright 2013 Julien Kowalski.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "config.h"
+#include "rand.h"
+#include "clock.h"
+
+#include "ecl/config.h"
+#include "ecl/errcode.h"
+#include "ecl/bigint/FixedSizedInt.h"
+
+using namespace ecl;
+
+/** @ingroup BigInt
+ @defgroup WideProduct Test suite for full width products and Barrett
+ reduction.
+ mul_wide and sqr_wide are checked against the truncated product of the
+ double size integers, barrett_reduce against values built as q.m + r.
+ @addtogroup WideProduct
+ @{
+ */
+template<class Int>
+class WideProductTest : public testing::Test {
+ public:
+  typedef FixedSizedInt<2 * Int::nb_limbs_> Wide;
+
+  /** zero extends a to the double size */
+  static void widen(Wide *res, const Int &a) {
+    res->zero();
+    memcpy(res->val, a.val, sizeof(a.val));
+  }
+
+  Int a, b, m;
+  Wide res1, res2, wa, wb;
+};
+
+TYPED_TEST_CASE_P(WideProductTest);
+
+TYPED_TEST_P(WideProductTest, Products){
+const int n = TypeParam::nb_limbs_;
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->a.rand(my_rand, NULL);
+  this->b.rand(my_rand, NULL);
+  switch (i % 4) {
+    case 0:
+      /** <ul><li> largest operands */
+      memset(this->a.val, 0xff, sizeof(this->a.val));
+      memset(this->b.val, 0xff, sizeof(this->b.val));
+      break;
+    case 1:
+      /** <li> equal halves */
+      memcpy(this->a.val + n / 2, this->a.val, (n / 2) * sizeof(ecl_digit));
+      this->b.val[n - 1] = 0;
+      break;
+    default:
+      break;
+  }
+  /** <li> mul_wide(a, b) == a.b */
+  this->widen(&this->wa, this->a);
+  this->widen(&this->wb, this->b);
+  TypeParam::mul_wide(&this->res1, this->a, this->b);
+  TestFixture::Wide::mul(&this->res2, this->wa, this->wb);
+  ASSERT_TRUE(this->res1.eq(this->res2));
+  /** <li> sqr_wide(a) == a.a */
+  TypeParam::sqr_wide(&this->res1, this->a);
+  TestFixture::Wide::mul(&this->res2, this->wa, this->wa);
+  ASSERT_TRUE(this->res1.eq(this->res2));
+  /**</ul>*/
+}
+}
+
+TYPED_TEST_P(WideProductTest, Barrett){
+const int n = TypeParam::nb_limbs_;
+typename TestFixture::Wide mu;
+TypeParam q, r, res;
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->m.rand(my_rand, NULL);
+  if (this->m.val[n - 1] == 0) {
+    this->m.val[n - 1] = 1;
+  }
+  if (i == 0) {
+    /** <ul><li> largest modulus */
+    memset(this->m.val, 0xff, sizeof(this->m.val));
+  }
+  TypeParam::barrett_setup(&mu, this->m);
+
+  /** <li> (q.m + r) mod m == r, q < m, r < m */
+  q.rand(my_rand, NULL);
+  q.val[n - 1] = 0;
+  r.rand(my_rand, NULL);
+  r.val[n - 1] = 0;
+  if (i % 4 == 1) {
+    /** <li> largest value, m^2 - 1 */
+    TypeParam::sub(&q, this->m, 1);
+    r.copy(q);
+  }
+  TypeParam::mul_wide(&this->res1, q, this->m);
+  this->widen(&this->res2, r);
+  TestFixture::Wide::add(&this->res1, this->res1, this->res2);
+  TypeParam::barrett_reduce(&res, this->res1, this->m, mu);
+  ASSERT_TRUE(res.eq(r));
+  /**</ul>*/
+}
+}
+
+TYPED_TEST_P(WideProductTest, Performance){
+typename TestFixture::Wide mu;
+TypeParam res;
+uint64_t overhead;
+
+this->a.rand(my_rand, NULL);
+this->b.rand(my_rand, NULL);
+this->m.rand(my_rand, NULL);
+this->m.val[TypeParam::nb_limbs_ - 1] |= 1;
+TypeParam::barrett_setup(&mu, this->m);
+
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("multiplication", TypeParam::mul_wide(&this->res1, this->a, this->b), overhead);
+GET_PERF_CLOCKS("        square", TypeParam::sqr_wide(&this->res1, this->a), overhead);
+GET_PERF_CLOCKS("       barrett", TypeParam::barrett_reduce(&res, this->res1, this->m, mu), overhead);
+}
+
+REGISTER_TYPED_TEST_CASE_P(WideProductTest, Products, Barrett, Performance);
+
+INSTANTIATE_TYPED_TEST_CASE_P(Int4, WideProductTest, FixedSizedInt<4>);
+INSTANTIATE_TYPED_TEST_CASE_P(Int6, WideProductTest, FixedSizedInt<6>);
+INSTANTIATE_TYPED_TEST_CASE_P(Int8, WideProductTest, FixedSizedInt<8>);
+
+/** adds a.B^off to r, B = 2^DIGIT_BITS */
+static void add_at(FixedSizedInt<32> *r, const FixedSizedInt<16> &a,
+                   int off) {
+  ecl_word w, c = 0;
+
+  for (int i = off; i < 32; i++) {
+    w = (ecl_word) r->val[i] + (i - off < 16 ? a.val[i - off] : 0) + c;
+    r->val[i] = (ecl_digit) w;
+    c = w >> DIGIT_BITS;
+  }
+}
+
+TEST(WideProduct, Karatsuba16){
+FixedSizedInt<16> a, b, t;
+FixedSizedInt<8> a0, a1, b0, b1;
+FixedSizedInt<32> res1, res2;
+
+for (int i = 0; i < NBTESTS; i++) {
+  a.rand(my_rand, NULL);
+  b.rand(my_rand, NULL);
+  switch (i % 4) {
+    case 0:
+      /** <ul><li> largest operands */
+      memset(a.val, 0xff, sizeof(a.val));
+      memset(b.val, 0xff, sizeof(b.val));
+      break;
+    case 1:
+      /** <li> equal halves, the cross term is zero */
+      memcpy(a.val + 8, a.val, 8 * sizeof(ecl_digit));
+      break;
+    default:
+      break;
+  }
+  /** <li> mul_wide(a, b) == a0.b0 + (a0.b1 + a1.b0).B^8 + a1.b1.B^16 */
+  memcpy(a0.val, a.val, sizeof(a0.val));
+  memcpy(a1.val, a.val + 8, sizeof(a1.val));
+  memcpy(b0.val, b.val, sizeof(b0.val));
+  memcpy(b1.val, b.val + 8, sizeof(b1.val));
+  memset(res2.val, 0, sizeof(res2.val));
+  FixedSizedInt<8>::mul_wide(&t, a0, b0);
+  add_at(&res2, t, 0);
+  FixedSizedInt<8>::mul_wide(&t, a0, b1);
+  add_at(&res2, t, 8);
+  FixedSizedInt<8>::mul_wide(&t, a1, b0);
+  add_at(&res2, t, 8);
+  FixedSizedInt<8>::mul_wide(&t, a1, b1);
+  add_at(&res2, t, 16);
+  FixedSizedInt<16>::mul_wide(&res1, a, b);
+  ASSERT_EQ(0, memcmp(res1.val, res2.val, sizeof(res1.val)));
+  /** <li> sqr_wide(a) == mul_wide(a, a) */
+  FixedSizedInt<16>::sqr_wide(&res1, a);
+  FixedSizedInt<16>::mul_wide(&res2, a, a);
+  ASSERT_EQ(0, memcmp(res1.val, res2.val, sizeof(res1.val)));
+  /**</ul>*/
+}
+}
+/**@}*/
+
+/** Tests the big endian and little endian binary representations.
+ */
+TEST(Bytes, RoundTrip){
+FixedSizedInt<NB_LIMBS> a, b;
+unsigned char be[40], le[40];
+char hex[2 * 32 + 1];
+
+for (int i = 0; i < NBTESTS; i++) {
+  a.rand(my_rand, NULL);
+  /** <ul><li> big endian bytes are the radix 16 representation */
+  ASSERT_EQ(ERR_OK, a.toBytes(be, 32, BYTES_BE));
+  for (int j = 0; j < 32; j++) {
+    snprintf(hex + 2 * j, 3, "%02x", be[j]);
+  }
+  ASSERT_EQ(a.toString(), string(hex));
+  /** <li> little endian bytes are the reversed big endian ones */
+  ASSERT_EQ(ERR_OK, a.toBytes(le, 32, BYTES_LE));
+  for (int j = 0; j < 32; j++) {
+    ASSERT_EQ(be[j], le[31 - j]);
+  }
+  /** <li> fromBytes(toBytes(a)) == a */
+  ASSERT_EQ(ERR_OK, b.fromBytes(be, 32, BYTES_BE));
+  ASSERT_TRUE(a.eq(b));
+  ASSERT_EQ(ERR_OK, b.fromBytes(le, 32, BYTES_LE));
+  ASSERT_TRUE(a.eq(b));
+  /** <li> longer buffers are zero padded */
+  ASSERT_EQ(ERR_OK, a.toBytes(be, 40, BYTES_BE));
+  ASSERT_EQ(ERR_OK, a.toBytes(le, 40, BYTES_LE));
+  for (int j = 0; j < 8; j++) {
+    ASSERT_EQ(0, be[j]);
+    ASSERT_EQ(0, le[32 + j]);
+  }
+  ASSERT_EQ(ERR_OK, b.fromBytes(be, 40, BYTES_BE));
+  ASSERT_TRUE(a.eq(b));
+  /** <li> values not fitting in the buffer are rejected */
+  a.val[NB_LIMBS - 1] |= (ecl_digit) 1 << (DIGIT_BITS - 1);
+  ASSERT_EQ(ERR_INVALID_VALUE, a.toBytes(be, 31, BYTES_BE));
+  a.val[NB_LIMBS - 1] = 1;
+  ASSERT_EQ(ERR_INVALID_VALUE, a.toBytes(le, 32 - DIGIT_BYTES, BYTES_LE));
+  a.val[NB_LIMBS - 1] = 0;
+  ASSERT_EQ(ERR_OK, a.toBytes(le, 32 - DIGIT_BYTES, BYTES_LE));
+  be[0] = 1;
+  ASSERT_EQ(ERR_INVALID_VALUE, b.fromBytes(be, 40, BYTES_BE));
+  /**</ul>*/
+}
+}
@@ -15,6 +15,30 @@ using namespace ecl::curve;
 
 #define CHECK_ORDER true
 
+namespace ecl {
+namespace curve {
+
+/** Access to the cyclotomic squarings of BNPairing */
+class BNPairingInternals {
+ public:
+  static void sqr_cycl(BNPairing *ate, Fp12::Element *res,
+                       const Fp12::Element &f) {
+    ate->sqr_cycl(res, f);
+  }
+
+  static void sqr_compressed(BNPairing *ate, Fp12::Element *res,
+                             const Fp12::Element &f) {
+    ate->sqr_compressed(res, f);
+  }
+
+  static void decompress_batch(BNPairing *ate, Fp12::Element *g, size_t n) {
+    ate->decompress_batch(g, n);
+  }
+};
+
+}  // namespace curve
+}  // namespace ecl
+
 template<BnCurveDefinition def>
 class CurveWithDef {
  public:
@@ -146,8 +170,254 @@ for(int i=0; i<NBTESTS; i++) {
 return;
 }
 
+/** Verify that both final exponentiations give the same pairing.
+ */
+TYPED_TEST_P(BnPairingTest, FinalExp){
+GFp::Element k;
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->gfp->rand(&k, my_rand, NULL);
+  k.val[NB_LIMBS-1] = 0;
+  this->gfp_curve->mul(&this->P2, this->P, k);
+
+  /** - pair(kP, Q) with both squaring methods */
+  this->ate.setFinalExp(FINAL_EXP_GS);
+  this->ate.pair(&this->res1, this->P2, this->Q);
+  this->ate.setFinalExp(FINAL_EXP_COMPRESSED);
+  this->ate.pair(&this->res2, this->P2, this->Q);
+  ASSERT_EQ(0, this->fp12->cmp(this->res1, this->res2));
+}
+}
+
+/** Verify the decompression of compressed squares whose g1 is zero.
+ With f = g0 + g1.w + ... + g5.w^5, a cyclotomic h with g1 = 0 is built from
+ the compressed form relations, then its square root
+ f = h^((p^4 - p^2 + 2) / 2) in the cyclotomic subgroup of odd order
+ p^4 - p^2 + 1.
+ */
+TYPED_TEST_P(BnPairingTest, Decompress){
+Fp2 *fp2 = this->fp12->getBaseField()->getBaseField();
+Fp2::Element y, r, t0, t1, one, inv3, inv_xsi;
+Fp12::Element h, f, g[2];
+GFp::Element e;
+ErrCode rv;
+
+fp2->one(&one);
+fp2->mul(&inv3, one, 3);
+fp2->inv(&inv3, inv3);
+fp2->mul_xsi(&inv_xsi, one);
+fp2->inv(&inv_xsi, inv_xsi);
+
+for (int i = 0; i < NBTESTS; i++) {
+  /** - h from a random y with r = (xsi.y^3 - 1) / 3 / xsi a square :
+   g2 = 2.y / (r + 3), g5 = g2.sqrt(r / xsi), g4 = g2.y, g3 = 2.g5 / y and
+   g0 = (r - 1) / (r + 3) */
+  do {
+    fp2->rand(&y, my_rand, NULL);
+    fp2->sqr(&r, y);
+    fp2->mul(&r, r, y);
+    fp2->mul_xsi(&r, r);
+    fp2->sub(&r, r, one);
+    fp2->mul(&r, r, inv3);
+    fp2->mul(&t0, r, inv_xsi);
+    rv = fp2->sqrt(&t0, t0);
+  } while (rv == ERR_NOT_SQUARE);
+  ASSERT_EQ(ERR_OK, rv);
+  this->fp12->zero(&h);
+  fp2->mul(&t1, one, 3);
+  fp2->add(&t1, r, t1);
+  fp2->inv(&t1, t1);
+  fp2->mul(&(h[0][1]), y, t1);
+  fp2->add(&(h[0][1]), h[0][1], h[0][1]);
+  fp2->mul(&(h[1][2]), h[0][1], t0);
+  fp2->mul(&(h[0][2]), h[0][1], y);
+  fp2->inv(&t0, y);
+  fp2->mul(&(h[1][1]), h[1][2], t0);
+  fp2->add(&(h[1][1]), h[1][1], h[1][1]);
+  fp2->sub(&t0, r, one);
+  fp2->mul(&(h[0][0]), t0, t1);
+
+  /** - h is cyclotomic : h^(p^6 + 1) = 1 and h^(p^4 + 1) = h^(p^2) */
+  this->fp12->conj(&this->res1, h);
+  this->fp12->mul(&this->res1, this->res1, h);
+  ASSERT_TRUE(this->fp12->isOne(this->res1));
+  this->fp12->frobenius(&this->res2, h, 2);
+  this->fp12->frobenius(&this->res1, this->res2, 2);
+  this->fp12->mul(&this->res1, this->res1, h);
+  ASSERT_EQ(0, this->fp12->cmp(this->res1, this->res2));
+
+  /** - f = h^((p^2 - 1) / 2 . p^2 + 1) and f^2 = h */
+  this->gfp->get_characteristic(&e);
+  GFp::Element::r_shift(&e, e, 1);
+  this->fp12->exp(&f, h, e);
+  this->fp12->frobenius(&this->res1, f, 1);
+  this->fp12->mul(&f, f, this->res1);
+  this->fp12->frobenius(&f, f, 2);
+  this->fp12->mul(&f, f, h);
+  BNPairingInternals::sqr_cycl(&this->ate, &this->res1, f);
+  ASSERT_EQ(0, this->fp12->cmp(this->res1, h));
+
+  /** - compressed f^2 has g1 = 0 and decompresses to sqr_cycl(f), also
+   together with another element */
+  this->fp12->zero(&(g[0]));
+  BNPairingInternals::sqr_compressed(&this->ate, &(g[0]), f);
+  ASSERT_TRUE(fp2->isZero(g[0][1][0]));
+  BNPairingInternals::decompress_batch(&this->ate, g, 1);
+  ASSERT_EQ(0, this->fp12->cmp(g[0], this->res1));
+
+  this->fp12->zero(&(g[0]));
+  this->fp12->zero(&(g[1]));
+  BNPairingInternals::sqr_compressed(&this->ate, &(g[0]), h);
+  BNPairingInternals::sqr_compressed(&this->ate, &(g[1]), f);
+  BNPairingInternals::decompress_batch(&this->ate, g, 2);
+  BNPairingInternals::sqr_cycl(&this->ate, &this->res2, h);
+  ASSERT_EQ(0, this->fp12->cmp(g[0], this->res2));
+  ASSERT_EQ(0, this->fp12->cmp(g[1], this->res1));
+}
+}
+
+/** Verify that pairings with a prepared point match the plain ones.
+ */
+TYPED_TEST_P(BnPairingTest, Prepared){
+GFp::Element k;
+PreparedG2 prepared;
+BNPairing other;
+GFpBnCurve::Point P1;
+Fp2BnCurve::Point Q1;
+
+this->fp2_curve->init(&this->Q2);
+
+/** - lines not prepared, or prepared by another object, are rejected */
+ASSERT_EQ(ERR_INVALID_VALUE, this->ate.pair(&this->res, this->P, prepared));
+ASSERT_EQ(ERR_OK, BNPairingFactory::getParameters(&other, &P1, &Q1,
+                                                  this->def));
+other.prepare(&prepared, this->Q);
+ASSERT_EQ(ERR_INVALID_VALUE, this->ate.pair(&this->res, this->P, prepared));
+ASSERT_EQ(ERR_OK, other.pair(&this->res, this->P, prepared));
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->gfp->rand(&k, my_rand, NULL);
+  k.val[NB_LIMBS-1] = 0;
+  this->gfp_curve->mul(&this->P2, this->P, k);
+  this->fp2_curve->mul(&this->Q2, this->Q, k);
+
+  /** - prepare [k]Q, previous lines are released */
+  this->ate.prepare(&prepared, this->Q2);
+
+  /** - pair(P, [k]Q) and pair([k]P, [k]Q) with and without preparation */
+  this->ate.pair(&this->res1, this->P, this->Q2);
+  ASSERT_EQ(ERR_OK, this->ate.pair(&this->res2, this->P, prepared));
+  ASSERT_EQ(0, this->fp12->cmp(this->res1, this->res2));
+
+  this->ate.pair(&this->res1, this->P2, this->Q2);
+  ASSERT_EQ(ERR_OK, this->ate.pair(&this->res2, this->P2, prepared));
+  ASSERT_EQ(0, this->fp12->cmp(this->res1, this->res2));
+}
+}
+
+/** Verify products of pairings and pairing equations.
+ */
+TYPED_TEST_P(BnPairingTest, MultiPair){
+GFp::Element k;
+GFpBnCurve::Point P[3];
+Fp2BnCurve::Point Q[3];
+
+for (int i = 0; i < 3; i++) {
+  this->gfp_curve->init(&(P[i]));
+  this->fp2_curve->init(&(Q[i]));
+}
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->gfp->rand(&k, my_rand, NULL);
+  k.val[NB_LIMBS-1] = 0;
+
+  /** - P = {[k]P, P, O}, Q = {Q, -[k]Q, Q} */
+  this->gfp_curve->mul(&(P[0]), this->P, k);
+  this->gfp_curve->copy(&(P[1]), this->P);
+  this->gfp_curve->setInfinity(&(P[2]));
+  this->fp2_curve->copy(&(Q[0]), this->Q);
+  this->fp2_curve->mul(&(Q[1]), this->Q, k);
+  this->fp2_curve->opp(&(Q[1]), Q[1]);
+  this->fp2_curve->copy(&(Q[2]), this->Q);
+
+  /** - Verify that multi_pair = pair(P0, Q0).pair(P1, Q1) */
+  this->ate.pair(&this->res1, P[0], Q[0]);
+  this->ate.pair(&this->res2, P[1], Q[1]);
+  this->fp12->mul(&this->res1, this->res1, this->res2);
+  this->ate.multi_pair(&this->res, P, Q, 2);
+  ASSERT_EQ(0, this->fp12->cmp(this->res, this->res1));
+
+  /** - Verify that the bilinearity equation holds, also with O */
+  ASSERT_TRUE(this->fp12->isOne(this->res));
+  ASSERT_TRUE(this->ate.pairing_check(P, Q, 2));
+  ASSERT_TRUE(this->ate.pairing_check(P, Q, 3));
+
+  /** - and does not once an argument is changed */
+  this->fp2_curve->copy(&(Q[1]), this->Q);
+  ASSERT_FALSE(this->ate.pairing_check(P, Q, 2));
+
+  /** - Verify that multi_pair = pair(P0, Q0).pair(P1, Q1)² with P2 = P1 */
+  this->gfp_curve->copy(&(P[2]), P[1]);
+  this->ate.pair(&this->res2, P[0], Q[0]);
+  this->ate.pair(&this->res, P[1], Q[1]);
+  this->fp12->mul(&this->res2, this->res2, this->res);
+  this->fp12->mul(&this->res2, this->res2, this->res);
+  this->ate.multi_pair(&this->res, P, Q, 3);
+  ASSERT_EQ(0, this->fp12->cmp(this->res, this->res2));
+
+  /** - Verify multi_pair of 17 pairs over several chunks,
+   e(P, Q).e([k]P, -Q).e(P, Q)... = e(P, Q).(e(P, Q) / e([k]P, Q))^8 */
+  GFpBnCurve::Point PM[17];
+  Fp2BnCurve::Point QM[17];
+  for (int j = 0; j < 17; j++) {
+    this->gfp_curve->init(&(PM[j]));
+    this->fp2_curve->init(&(QM[j]));
+    this->fp2_curve->copy(&(QM[j]), this->Q);
+    if (j % 2) {
+      this->gfp_curve->copy(&(PM[j]), P[0]);
+      this->fp2_curve->opp(&(QM[j]), QM[j]);
+    } else {
+      this->gfp_curve->copy(&(PM[j]), this->P);
+    }
+  }
+  this->ate.multi_pair(&this->res, PM, QM, 17);
+  this->ate.pair(&this->res1, this->P, this->Q);
+  this->ate.pair(&this->res2, P[0], this->Q);
+  this->fp12->conj(&this->res2, this->res2);
+  this->fp12->mul(&this->res2, this->res2, this->res1);
+  for (int j = 0; j < 3; j++) {
+    this->fp12->sqr(&this->res2, this->res2);
+  }
+  this->fp12->mul(&this->res2, this->res2, this->res1);
+  ASSERT_EQ(0, this->fp12->cmp(this->res, this->res2));
+}
+}
+
 TYPED_TEST_P(BnPairingTest, Performance){
+PreparedG2 prepared;
+GFpBnCurve::Point P[2];
+Fp2BnCurve::Point Q[2];
+
+for (int i = 0; i < 2; i++) {
+  this->gfp_curve->init(&(P[i]));
+  this->fp2_curve->init(&(Q[i]));
+  this->gfp_curve->copy(&(P[i]), this->P);
+  this->fp2_curve->copy(&(Q[i]), this->Q);
+}
+
 GET_PERF("BN pairing", this->ate.pair(&this->res, this->P, this->Q));
+GET_PERF("BN pairing, prepare", this->ate.prepare(&prepared, this->Q));
+GET_PERF("BN pairing, prepared Q", this->ate.pair(&this->res, this->P, prepared));
+this->ate.setFinalExp(FINAL_EXP_GS);
+GET_PERF("BN pairing, Granger-Scott squarings", this->ate.pair(&this->res, this->P, this->Q));
+this->ate.setFinalExp(FINAL_EXP_COMPRESSED);
+GET_PERF("BN pairing, compressed squarings", this->ate.pair(&this->res, this->P, this->Q));
+GET_PERF("BN pairing, 2 pairings", {
+  this->ate.pair(&this->res1, P[0], Q[0]);
+  this->ate.pair(&this->res2, P[1], Q[1]);
+  this->fp12->mul(&this->res, this->res1, this->res2);
+});
+GET_PERF("BN pairing, multi_pair of 2", this->ate.multi_pair(&this->res, P, Q, 2));
 return;
 }
 
@@ -155,7 +425,8 @@ return;
 // enumerate the tests you defined:
 REGISTER_TYPED_TEST_CASE_P(BnPairingTest,// The first argument is the test case name.
     // The rest of the arguments are the test names.
-    Bilinear, Bilinear2, Performance);
+    Bilinear, Bilinear2, FinalExp, Decompress, Prepared, MultiPair,
+    Performance);
 
 INSTANTIATE_TYPED_TEST_CASE_P(BEUCHAT_254, BnPairingTest,
                               CurveWithDef<BN_BEUCHAT_254>);
@@ -197,8 +197,17 @@ TYPED_TEST_P( EccGFp, Mul ){
 
 		/** <li>  verify that the calculated point and the test vector are equal */
 		ASSERT_EQ(0, this->curve.cmp(this->ref, this->res) );
+
+		/** <li>  same with every window size */
+		for (int w = 1; w <= GFpCurve::MAX_WINDOW_SZ; w++) {
+			ASSERT_EQ(ERR_OK, this->curve.mul_SW(&this->res, this->P, this->k, w) );
+			ASSERT_EQ(0, this->curve.cmp(this->ref, this->res) );
+		}
 	}
 	/** </ul> */
+	ASSERT_EQ(ERR_INVALID_VALUE, this->curve.mul_SW(&this->res, this->P, this->k, 0) );
+	ASSERT_EQ(ERR_INVALID_VALUE,
+	          this->curve.mul_SW(&this->res, this->P, this->k, GFpCurve::MAX_WINDOW_SZ + 1) );
 }
 
 /** Test point compression and decompression */
@@ -232,6 +241,50 @@ TYPED_TEST_P(EccGFp, Compression){
 	/** </ul> */
 }
 
+/** Test batch point compression and normalization, on points at infinity,
+ * with z = 1 and in jacobian coordinates */
+TYPED_TEST_P(EccGFp, CompressionBatch){
+	typename GFpCurve::Point pts[40];
+	typename GFp::Element xs[40];
+	int ys[40];
+
+	for(int j=0; j<40; j++) {
+		this->curve.init(&pts[j]);
+	}
+	/** <ul><li>  pts[j] = [j+1]P, but for two points at infinity */
+	this->curve.copy(&pts[0], this->P);
+	this->curve.dbl(&pts[1], this->P);
+	for(int j=2; j<40; j++) {
+		this->curve.add(&pts[j], pts[j - 1], this->P);
+	}
+	this->curve.setInfinity(&pts[2]);
+	this->curve.setInfinity(&pts[34]);
+
+	ASSERT_EQ(ERR_OK, this->curve.compress(xs, ys, pts, 40));
+
+	for(int j=0; j<40; j++) {
+		if (j == 2 || j == 34) continue;
+		/** <li>  Restore each point and compare with the original one */
+		ASSERT_EQ(ERR_OK, this->curve.decompress(&this->res, xs[j], ys[j]));
+		ASSERT_EQ(0, this->curve.cmp(pts[j], this->res) );
+	}
+
+	/** <li>  Batch normalization keeps the points unchanged */
+	this->curve.copy(&this->ref, pts[39]);
+	this->curve.normalize(pts, 40);
+	ASSERT_TRUE(this->curve.isInfinity(pts[2]));
+	ASSERT_TRUE(this->curve.isInfinity(pts[34]));
+	this->curve.dbl(&this->res, this->P);
+	ASSERT_EQ(0, this->curve.cmp(pts[1], this->res) );
+	ASSERT_EQ(0, this->curve.cmp(pts[39], this->ref) );
+	for(int j=0; j<40; j++) {
+		if (j == 2 || j == 34) continue;
+		ASSERT_TRUE(this->curve.getField()->isOne(pts[j].z));
+		ASSERT_TRUE(this->curve.getField()->isOne(pts[j].z2));
+	}
+	/** </ul> */
+}
+
 /** Test point multiplication (Montgommery ladder)
  */
 TYPED_TEST_P(EccGFp, Ladder){
@@ -264,6 +317,88 @@ TYPED_TEST_P(EccGFp, Ladder){
 	/** </ul> */
 }
 
+/** Test the scalar field of the curve
+ */
+TYPED_TEST_P(EccGFp, ScalarField){
+	Fr *fr = this->curve.getScalarField();
+	GFp::Element order, a, b, ab, k, ia[4], a4[4];
+	GFp::Double h, hk;
+	int naf[NB_LIMBS * DIGIT_BITS + 1], naf_sz;
+
+	ASSERT_TRUE( fr != NULL );
+	this->curve.get_order(&order);
+	this->curve.init(&this->res);
+	this->curve.init(&this->ref);
+	this->curve.init(&this->tP);
+
+	for(int j=0; j<8; j++) {
+		fr->rand(&a, my_rand, NULL);
+		fr->rand(&b, my_rand, NULL);
+
+		/** <li>  toInt(fromInt(k)) == k for test vectors scalars */
+		dirtyimport(&this->k, *fr, this->vectors[j % this->getNbTest()].k);
+		fr->fromInt(&a4[0], this->k);
+		fr->toInt(&k, a4[0]);
+		ASSERT_TRUE( k.eq(this->k) );
+
+		/** <li>  [a.b]P == [a]([b]P) */
+		fr->mul(&ab, a, b);
+		fr->toInt(&k, ab);
+		this->curve.mul(&this->ref, this->P, k);
+		fr->toInt(&k, b);
+		this->curve.mul(&this->tP, this->P, k);
+		fr->toInt(&k, a);
+		this->curve.mul(&this->res, this->tP, k);
+		ASSERT_EQ(0, this->curve.cmp(this->ref, this->res) );
+
+		/** <li>  [1/a]([a]P) == P */
+		fr->inv(&ab, a);
+		fr->toInt(&k, a);
+		this->curve.mul(&this->tP, this->P, k);
+		fr->toInt(&k, ab);
+		this->curve.mul(&this->res, this->tP, k);
+		ASSERT_EQ(0, this->curve.cmp(this->P, this->res) );
+
+		/** <li>  batch inversion matches single inversions */
+		for(int i=0; i<4; i++) {
+			fr->rand(&a4[i], my_rand, NULL);
+		}
+		fr->inv_batch(ia, a4, 4);
+		for(int i=0; i<4; i++) {
+			fr->inv(&ab, a4[i]);
+			ASSERT_EQ(0, fr->cmp(ab, ia[i]) );
+		}
+
+		/** <li>  fromWide(q.r + k) == k, q < R, k < r */
+		fr->toInt(&k, b);
+		GFp::Element::mul_wide(&h, a, order);
+		hk.zero();
+		memcpy(hk.val, k.val, sizeof(k.val));
+		GFp::Double::add(&h, h, hk);
+		fr->fromWide(&ab, h);
+		ASSERT_EQ(0, fr->cmp(ab, b) );
+		fr->reduce_wide(&this->comp, h);
+		ASSERT_TRUE( this->comp.eq(k) );
+
+		/** <li>  fromWide(R^2 - 1) == (R - 1).R + R - 1 */
+		memset(h.val, 0xff, sizeof(h.val));
+		fr->fromWide(&ab, h);
+		memset(k.val, 0xff, sizeof(k.val));
+		fr->fromInt(&a4[0], k);
+		fr->one(&a4[1]);
+		fr->add(&a4[1], a4[1], a4[0]);
+		fr->mul(&a4[1], a4[1], a4[0]);
+		fr->add(&a4[1], a4[1], a4[0]);
+		ASSERT_EQ(0, fr->cmp(ab, a4[1]) );
+
+		/** <li>  fromWNAF(get_wNAF(a)) == a */
+		fr->get_wNAF(naf, &naf_sz, a, 4);
+		fr->fromWNAF(&b, naf, naf_sz);
+		ASSERT_EQ(0, fr->cmp(a, b) );
+	}
+	/** </ul> */
+}
+
 TYPED_TEST_P(EccGFp, Performance){
 	GFp::Element order;
 	this->curve.get_order(&order);
@@ -288,7 +423,8 @@ TYPED_TEST_P(EccGFp, Performance){
 // enumerate the tests you defined:
 REGISTER_TYPED_TEST_CASE_P(EccGFp,// The first argument is the test case name.
 		// The rest of the arguments are the test names.
-		Double, Add, Mul, Compression, Ladder, Performance);
+		Double, Add, Mul, Compression, CompressionBatch, Ladder, ScalarField,
+		Performance);
 
 /** Perform generic tests for NIST_P256 curve */
 INSTANTIATE_TYPED_TEST_CASE_P(NIST_P256, EccGFp, CurveWithDef<NIST_P256>);
@@ -12,6 +12,7 @@
 
 #include "ecl/config.h"
 #include "ecl/types.h"
+#include "ecl/dispatch.h"
 
 #include "ecl/digest/sha256.h"
 
@@ -91,4 +92,71 @@ TEST(Digest, Sha256_2) {
 
 }
 
+/** Same digests with every backend the cpu supports (SHA-NI), in a single
+ * update of several blocks and byte per byte.
+ */
+TEST(Digest, Sha256Backends) {
+  Sha256 md;
+  FixedSizedBuffer<32> result, reference;
+  Buffer buff;
+
+  for (int i = 0; i < 1000; i++) {
+    buff.push_back(static_cast<unsigned char>(i * 7 + 3));
+  }
+  ASSERT_EQ(ERR_OK, setBackend(BACKEND_GENERIC));
+  md.hash(&reference, buff);
+
+  for (int be = BACKEND_GENERIC; be < BACKEND_AUTO; be++) {
+    if (setBackend(static_cast<Backend>(be)) != ERR_OK) {
+      continue;
+    }
+    for (int i = 0; i < 3; i++) {
+      md.hash(&result, sha2_test_buf[i]);
+      FixedSizedBuffer<32> test_vector;
+      test_vector = sha256_test_vector[i];
+      ASSERT_TRUE(test_vector == result);
+    }
+    md.hash(&result, buff);
+    ASSERT_TRUE(reference == result);
+    md.init();
+    for (size_t i = 0; i < buff.size(); i++) {
+      md.update(Buffer(1, buff[i]));
+    }
+    md.final(&result);
+    ASSERT_TRUE(reference == result);
+  }
+  setBackend(BACKEND_AUTO);
+}
+
+/** Message split across updates that do not end on block boundaries, the
+ * pending bytes shall be hashed before the following whole blocks.
+ */
+TEST(Digest, Sha256Split) {
+  Sha256 md;
+  FixedSizedBuffer<32> result, reference;
+  Buffer buff;
+  size_t splits[] = {1, 10, 63, 64, 65, 100, 128, 200};
+
+  for (int i = 0; i < 300; i++) {
+    buff.push_back(static_cast<unsigned char>(i * 13 + 5));
+  }
+  md.hash(&reference, buff);
+
+  for (size_t s : splits) {
+    md.init();
+    md.update(Buffer(buff.begin(), buff.begin() + s));
+    md.update(Buffer(buff.begin() + s, buff.end()));
+    md.final(&result);
+    ASSERT_TRUE(reference == result) << "split at " << s;
+
+    // two partial updates then the remainder
+    md.init();
+    md.update(Buffer(buff.begin(), buff.begin() + 10));
+    md.update(Buffer(buff.begin() + 10, buff.begin() + 10 + s));
+    md.update(Buffer(buff.begin() + 10 + s, buff.end()));
+    md.final(&result);
+    ASSERT_TRUE(reference == result) << "split at 10 and " << 10 + s;
+  }
+}
+
 } //namespace ecl
@@ -9,16 +9,20 @@
 
 #include <gtest/gtest.h>
 
+#include <type_traits>
+
 #include "config.h"
 #include "rand.h"
 #include "clock.h"
 
 #include "ecl/config.h"
 #include "ecl/errcode.h"
+#include "ecl/dispatch.h"
 #include "ecl/field/GFp.h"
 #include "ecl/field/Fp2.h"
 #include "ecl/field/Fp6.h"
 #include "ecl/field/Fp12.h"
+#include "ecl/field/StaticGFp.h"
 
 using namespace ecl::field;
 
@@ -95,6 +99,15 @@ this->field->set(&this->a, 1);
 ASSERT_TRUE(this->field->isOne(this->a) );
 }
 
+/** Tests that elements are plain, densely packed limb arrays.
+ */
+TYPED_TEST_P(GenericFieldTest, Layout){
+typedef typename TypeParam::Element Elt;
+ASSERT_TRUE(std::is_trivially_copyable<Elt>::value);
+ASSERT_EQ(TypeParam::getExtensionDegre() * NB_LIMBS * DIGIT_BYTES, (int) sizeof(Elt));
+ASSERT_EQ(0, (int) (alignof(Elt) % 32));
+}
+
 /** Tests that if the function result is also an operand, the result is still right.
  The test performs the following operations NB_TESTS times :
  */
@@ -187,6 +200,7 @@ for(int i=0; i<NBTESTS; i++) {
   /** <ul><li> Generate three random elements a, b and c in field */
   this->field->rand(&this->a, my_rand, NULL);
   this->field->rand(&this->b, my_rand, NULL);
+  this->field->rand(&this->c, my_rand, NULL);
 
   this->field->set(&this->res1, 0);
   this->field->set(&this->res2, 0);
@@ -298,6 +312,35 @@ for(int i=0; i<NBTESTS; i++) {
 /** </ul> */
 }
 
+/** Tests simultaneous inversion against single inversions, zero elements
+ included, in place with a scratch.
+ */
+TYPED_TEST_P(GenericFieldTest, InvBatch){
+typename TypeParam::Element in[40], out[40], scratch[40];
+
+for(int j=0; j<40; j++) {
+  this->field->rand(&in[j], my_rand, NULL);
+}
+this->field->set(&in[3], 0);
+this->field->set(&in[35], 0);
+
+this->field->inv_batch(out, in, 40);
+for(int j=0; j<40; j++) {
+  if (j == 3 || j == 35) {
+    ASSERT_TRUE(this->field->isZero(out[j]));
+  } else {
+    this->field->inv(&this->res1, in[j]);
+    ASSERT_EQ(0, this->field->cmp(this->res1, out[j]));
+  }
+}
+
+/** in place inversion */
+this->field->inv_batch(in, in, 40, scratch);
+for(int j=0; j<40; j++) {
+  ASSERT_EQ(0, this->field->cmp(in[j], out[j]));
+}
+}
+
 TYPED_TEST_P(GenericFieldTest, Scalar){
 ecl_digit scal;
 for(int i=0; i<NBTESTS; i++) {
@@ -358,6 +401,7 @@ uint64_t overhead;
 
 this->field->rand(&this->a, my_rand, NULL);
 this->field->rand(&this->b, my_rand, NULL);
+this->field->rand(&this->c, my_rand, NULL);
 
 GET_OVERHEAD(overhead);
 GET_PERF_CLOCKS("      addition", this->field->add(&this->c, this->c, this->b), overhead);
@@ -387,13 +431,984 @@ GET_PERF("       inverse", this->field->inv(&this->c, this->c));
 REGISTER_TYPED_TEST_CASE_P(
     GenericFieldTest,  // The first argument is the test case name.
     // The rest of the arguments are the test names.
-    Set,
-    Target, AddSub, MulInv, Scalar, Exponentiation, Frobenius,
+    Set, Layout,
+    Target, AddSub, MulInv, InvBatch, Scalar, Exponentiation, Frobenius,
     Performance);
 
 INSTANTIATE_TYPED_TEST_CASE_P(GFp, GenericFieldTest, GFp);
 INSTANTIATE_TYPED_TEST_CASE_P(Fp2, GenericFieldTest, Fp2);
 INSTANTIATE_TYPED_TEST_CASE_P(Fp6, GenericFieldTest, Fp6);
 INSTANTIATE_TYPED_TEST_CASE_P(Fp12, GenericFieldTest, Fp12);
+
+/** Tests that Public and Secret elements are accepted by the field API.
+ */
+TEST(ElementPolicy, PublicSecret){
+GFp gfp("b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af");
+ecl::Public<GFp::Element> a;
+ecl::Secret<GFp::Element> b;
+GFp::Element c, d;
+
+ASSERT_TRUE(b.isZero());
+gfp.set(&a, 3);
+gfp.set(&b, 5);
+gfp.mul(&c, a, b);
+gfp.set(&d, 15);
+ASSERT_EQ(0, gfp.cmp(c, d));
+gfp.mul(&a, a, b);
+ASSERT_EQ(0, gfp.cmp(a, d));
+}
+
+/** Tests constant time and variable time inversions against each other,
+ * on random and edge values.
+ */
+TEST(GFpInverse, SafeGcd){
+GFp gfp("b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af");
+GFp::Element a, b, c, one, zero;
+
+gfp.set(&one, 1);
+gfp.set(&zero, 0);
+
+/** <ul><li> inv(0) == inv_vartime(0) == 0 */
+gfp.inv(&b, zero);
+ASSERT_EQ(0, gfp.cmp(b, zero));
+gfp.inv_vartime(&b, zero);
+ASSERT_EQ(0, gfp.cmp(b, zero));
+/** <li> inv(1) == inv_vartime(1) == 1 */
+gfp.inv(&b, one);
+ASSERT_EQ(0, gfp.cmp(b, one));
+gfp.inv_vartime(&b, one);
+ASSERT_EQ(0, gfp.cmp(b, one));
+/** <li> inv(-1) == -1 */
+gfp.opp(&a, one);
+gfp.inv(&b, a);
+ASSERT_EQ(0, gfp.cmp(b, a));
+gfp.inv_vartime(&b, a);
+ASSERT_EQ(0, gfp.cmp(b, a));
+/** <li> a . inv(a) == 1 and inv(a) == inv_vartime(a) */
+for (int i = 0; i < 200; i++) {
+  gfp.rand(&a, my_rand, NULL);
+  if (gfp.isZero(a)) {
+    continue;
+  }
+  gfp.inv(&b, a);
+  gfp.inv_vartime(&c, a);
+  ASSERT_EQ(0, gfp.cmp(b, c));
+  gfp.mul(&c, a, b);
+  ASSERT_EQ(0, gfp.cmp(c, one));
+}
+/**</ul>*/
+}
+
+TEST(GFpInverse, Performance){
+GFp gfp("b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af");
+GFp::Element a;
+uint64_t overhead;
+
+gfp.rand(&a, my_rand, NULL);
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("       inverse", gfp.inv(&a, a), overhead);
+GET_PERF_CLOCKS("inverse vartim", gfp.inv_vartime(&a, a), overhead);
+}
+
+/** Tests lazy additions and subtractions, for a 254 bits prime (p < R/4)
+ * and a 256 bits prime (reduced results).
+ */
+TEST(GFpLazy, AddSub){
+const char *primes[2] = {
+  "2523648240000001ba344d80000000086121000000000013a700000000000013",
+  "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af" };
+GFp::Element a, b, c, d, l1, l2, r1, r2, p, p2;
+
+for (int k = 0; k < 2; k++) {
+  GFp gfp(primes[k]);
+  gfp.get_characteristic(&p);
+  GFp::Element::add(&p2, p, p);
+
+  for (int i = 0; i < NBTESTS; i++) {
+    gfp.rand(&a, my_rand, NULL);
+    gfp.rand(&b, my_rand, NULL);
+    gfp.rand(&c, my_rand, NULL);
+    gfp.rand(&d, my_rand, NULL);
+    if (i == 0) {
+      /** <ul><li> largest lazy values, (p - 1) + (p - 1) and 0 - (p - 1) */
+      GFp::Element::sub(&a, p, 1);
+      b.copy(a);
+      c.zero();
+      d.copy(a);
+    }
+    /** <li> lazy results lie in [0, 2p[, reduced ones for the 256 bits prime */
+    gfp.add_lazy(&l1, a, b);
+    gfp.sub_lazy(&l2, c, d);
+    ASSERT_EQ(1, gfp.cmp(l1, k == 0 ? p2 : p));
+    ASSERT_EQ(1, gfp.cmp(l2, k == 0 ? p2 : p));
+
+    /** <li> (a + b).(c - d) and (a + b)^2 match the reduced computation */
+    gfp.add(&r1, a, b);
+    gfp.sub(&r2, c, d);
+    gfp.mul(&l1, l1, l2);
+    gfp.mul(&r1, r1, r2);
+    ASSERT_EQ(0, gfp.cmp(l1, r1));
+    gfp.add_lazy(&l1, a, b);
+    gfp.add(&r1, a, b);
+    gfp.sqr(&l1, l1);
+    gfp.sqr(&r1, r1);
+    ASSERT_EQ(0, gfp.cmp(l1, r1));
+  }
+  /**</ul>*/
+}
+}
+
+TEST(GFpLazy, Performance){
+GFp gfp("2523648240000001ba344d80000000086121000000000013a700000000000013");
+GFp::Element a, b, c;
+uint64_t overhead;
+
+gfp.rand(&a, my_rand, NULL);
+gfp.rand(&b, my_rand, NULL);
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("      addition", gfp.add(&c, a, b), overhead);
+GET_PERF_CLOCKS(" lazy addition", gfp.add_lazy(&c, a, b), overhead);
+GET_PERF_CLOCKS("  substraction", gfp.sub(&c, a, b), overhead);
+GET_PERF_CLOCKS("lazy substract", gfp.sub_lazy(&c, a, b), overhead);
+}
+
+/** Tests the batched multiplications against the element wise ones, for a
+ * prime with spare bits, a 256 bits one and P-256, with every backend.
+ */
+TEST(GFpBatch, MulSqr){
+const char *primes[3] = {
+  "2523648240000001ba344d80000000086121000000000013a700000000000013",
+  "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af",
+  "ffffffff00000001000000000000000000000000ffffffffffffffffffffffff" };
+const int n = 15;
+GFp::Element a[n], b[n], res[n], r, p;
+Fp2::Element a2[n], b2[n], res2[n], r2;
+
+/** <ul><li> with every backend the cpu supports */
+for (int be = ecl::BACKEND_GENERIC; be < ecl::BACKEND_AUTO; be++) {
+  if (ecl::setBackend(static_cast<ecl::Backend>(be)) != ecl::ERR_OK) {
+    continue;
+  }
+  for (int k = 0; k < 3; k++) {
+    GFp gfp(primes[k]);
+    gfp.get_characteristic(&p);
+
+    for (int i = 0; i < NBTESTS; i++) {
+      for (int j = 0; j < n; j++) {
+        gfp.rand(&a[j], my_rand, NULL);
+        gfp.rand(&b[j], my_rand, NULL);
+      }
+      /** <ul><li> largest operands, p - 1, p (opp(0)) and zero */
+      GFp::Element::sub(&a[0], p, 1);
+      b[0].copy(a[0]);
+      b[1].copy(p);
+      a[2].zero();
+      /** <li> lazy operands for the prime with spare bits */
+      gfp.add_lazy(&a[5], a[0], b[0]);
+      gfp.sub_lazy(&b[6], b[1], a[0]);
+
+      /** <li> mul_batch(a, b) == a.b and sqr_batch(a) == a.a, n not a multiple
+       * of 4 */
+      gfp.mul_batch(res, a, b, n);
+      for (int j = 0; j < n; j++) {
+        gfp.mul(&r, a[j], b[j]);
+        ASSERT_EQ(0, gfp.cmp(r, res[j]));
+      }
+      gfp.sqr_batch(res, a, n);
+      for (int j = 0; j < n; j++) {
+        gfp.sqr(&r, a[j]);
+        ASSERT_EQ(0, gfp.cmp(r, res[j]));
+      }
+      /** <li> in place */
+      gfp.mul_batch(b, a, b, n);
+      gfp.sqr_batch(a, a, n);
+      ASSERT_EQ(0, memcmp(a, res, sizeof(a)));
+    }
+
+    if (k == 2) {
+      continue;
+    }
+    /** <li> Fp2 batches over the first two primes */
+    Fp2 fp2(primes[k]);
+    for (int i = 0; i < NBTESTS; i++) {
+      for (int j = 0; j < n; j++) {
+        fp2.rand(&a2[j], my_rand, NULL);
+        fp2.rand(&b2[j], my_rand, NULL);
+      }
+      fp2.mul_batch(res2, a2, b2, n);
+      for (int j = 0; j < n; j++) {
+        fp2.mul(&r2, a2[j], b2[j]);
+        ASSERT_EQ(0, fp2.cmp(r2, res2[j]));
+      }
+      fp2.sqr_batch(res2, a2, n);
+      for (int j = 0; j < n; j++) {
+        fp2.sqr(&r2, a2[j]);
+        ASSERT_EQ(0, fp2.cmp(r2, res2[j]));
+      }
+    }
+    /**</ul>*/
+  }
+}
+ecl::setBackend(ecl::BACKEND_AUTO);
+/**</ul>*/
+}
+
+TEST(GFpBatch, Performance){
+GFp gfp("2523648240000001ba344d80000000086121000000000013a700000000000013");
+GFp::Element a[8], b[8], res[8];
+uint64_t overhead;
+
+for (int j = 0; j < 8; j++) {
+  gfp.rand(&a[j], my_rand, NULL);
+  gfp.rand(&b[j], my_rand, NULL);
+}
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("           mul", gfp.mul(&res[0], a[0], b[0]), overhead);
+GET_PERF_CLOCKS(" mul_batch (8)", gfp.mul_batch(res, a, b, 8), overhead);
+}
+
+/** Tests the binary representations of GFp, Fp2 and Fp12 elements.
+ */
+TEST(GFpBytes, Codec){
+const char *prime =
+    "2523648240000001ba344d80000000086121000000000013a700000000000013";
+const int n = 15;
+GFp gfp(prime);
+Fp2 fp2(prime);
+Fp12 fp12(prime);
+GFp::Element a[n], b[n], r, p;
+Fp2::Element a2[n], b2[n];
+Fp12::Element a12[3], b12[3];
+unsigned char be[n * 32], le[n * 32], buf[3 * 12 * 32];
+
+gfp.get_characteristic(&p);
+ASSERT_EQ(32u, gfp.getByteSize());
+ASSERT_EQ(64u, fp2.getByteSize());
+ASSERT_EQ(384u, fp12.getByteSize());
+
+/** <ul><li> 0x1234 is written 12 34 in big endian, 34 12 in little endian */
+gfp.set(&a[0], 0x1234);
+gfp.toBytes(be, a[0], ecl::BYTES_BE);
+gfp.toBytes(le, a[0], ecl::BYTES_LE);
+ASSERT_EQ(0x12, be[30]);
+ASSERT_EQ(0x34, be[31]);
+ASSERT_EQ(0x34, le[0]);
+ASSERT_EQ(0x12, le[1]);
+for (int j = 2; j < 32; j++) {
+  ASSERT_EQ(0, be[31 - j]);
+  ASSERT_EQ(0, le[j]);
+}
+
+for (int i = 0; i < NBTESTS; i++) {
+  for (int j = 0; j < n; j++) {
+    gfp.rand(&a[j], my_rand, NULL);
+  }
+  /** <li> largest value, p - 1, and zero given as p (opp(0)) */
+  gfp.one(&a[0]);
+  gfp.opp(&a[0], a[0]);
+  gfp.zero(&a[1]);
+  gfp.opp(&a[1], a[1]);
+
+  /** <li> big endian bytes are the integer read by fromString() */
+  gfp.toBytes(be, a[2], ecl::BYTES_BE);
+  r.fromBytes(be, 32, ecl::BYTES_BE);
+  ASSERT_EQ(ecl::ERR_OK, gfp.fromString(&b[2], r.toString()));
+  ASSERT_EQ(0, gfp.cmp(a[2], b[2]));
+
+  /** <li> batches give the same bytes as single conversions */
+  gfp.toBytes(be, a, n, ecl::BYTES_BE);
+  gfp.toBytes(le, a, n, ecl::BYTES_LE);
+  for (int j = 0; j < n; j++) {
+    gfp.toBytes(buf, a[j], ecl::BYTES_BE);
+    ASSERT_EQ(0, memcmp(buf, be + 32 * j, 32));
+    gfp.toBytes(buf, a[j], ecl::BYTES_LE);
+    ASSERT_EQ(0, memcmp(buf, le + 32 * j, 32));
+  }
+  GFp::Element::sub(&r, p, 1);
+  r.toBytes(buf, 32, ecl::BYTES_BE);
+  ASSERT_EQ(0, memcmp(buf, be, 32));
+  memset(buf, 0, 32);
+  ASSERT_EQ(0, memcmp(buf, be + 32, 32));
+
+  /** <li> fromBytes(toBytes(a)) == a, single and batch, p being read back
+   * as zero */
+  gfp.zero(&a[1]);
+  for (int j = 0; j < n; j++) {
+    ASSERT_EQ(ecl::ERR_OK, gfp.fromBytes(&b[j], le + 32 * j, ecl::BYTES_LE));
+    ASSERT_EQ(0, gfp.cmp(a[j], b[j]));
+  }
+  ASSERT_EQ(ecl::ERR_OK, gfp.fromBytes(b, be, n, ecl::BYTES_BE));
+  for (int j = 0; j < n; j++) {
+    ASSERT_EQ(0, gfp.cmp(a[j], b[j]));
+  }
+
+  /** <li> integers not lower than p are rejected */
+  p.toBytes(be + 32 * (i % n), 32, ecl::BYTES_BE);
+  ASSERT_EQ(ecl::ERR_INVALID_VALUE,
+            gfp.fromBytes(&r, be + 32 * (i % n), ecl::BYTES_BE));
+  ASSERT_EQ(ecl::ERR_INVALID_VALUE, gfp.fromBytes(b, be, n, ecl::BYTES_BE));
+  for (int j = 0; j < n; j++) {
+    ASSERT_EQ(0, gfp.cmp(a[j], b[j]));
+  }
+  memset(le, 0xff, 32);
+  ASSERT_EQ(ecl::ERR_INVALID_VALUE, gfp.fromBytes(&r, le, ecl::BYTES_LE));
+
+  /** <li> Fp2 and Fp12 round trips, component by component */
+  for (int j = 0; j < n; j++) {
+    fp2.rand(&a2[j], my_rand, NULL);
+  }
+  fp2.toBytes(be, a2, n / 2, ecl::BYTES_BE);
+  gfp.toBytes(buf, a2[1][1], ecl::BYTES_BE);
+  ASSERT_EQ(0, memcmp(buf, be + 3 * 32, 32));
+  ASSERT_EQ(ecl::ERR_OK, fp2.fromBytes(b2, be, n / 2, ecl::BYTES_BE));
+  for (int j = 0; j < n / 2; j++) {
+    ASSERT_EQ(0, fp2.cmp(a2[j], b2[j]));
+    fp2.toBytes(buf, a2[j], ecl::BYTES_LE);
+    ASSERT_EQ(ecl::ERR_OK, fp2.fromBytes(&b2[j], buf, ecl::BYTES_LE));
+    ASSERT_EQ(0, fp2.cmp(a2[j], b2[j]));
+  }
+  for (int j = 0; j < 3; j++) {
+    fp12.rand(&a12[j], my_rand, NULL);
+  }
+  fp12.toBytes(buf, a12, 3, ecl::BYTES_LE);
+  gfp.toBytes(be, a12[1][1][2][1], ecl::BYTES_LE);
+  ASSERT_EQ(0, memcmp(be, buf + (12 + 11) * 32, 32));
+  ASSERT_EQ(ecl::ERR_OK, fp12.fromBytes(b12, buf, 3, ecl::BYTES_LE));
+  for (int j = 0; j < 3; j++) {
+    ASSERT_EQ(0, fp12.cmp(a12[j], b12[j]));
+  }
+  fp12.toBytes(buf, a12[2], ecl::BYTES_BE);
+  ASSERT_EQ(ecl::ERR_OK, fp12.fromBytes(&b12[2], buf, ecl::BYTES_BE));
+  ASSERT_EQ(0, fp12.cmp(a12[2], b12[2]));
+}
+/**</ul>*/
+}
+
+TEST(GFpBytes, Performance){
+GFp gfp("2523648240000001ba344d80000000086121000000000013a700000000000013");
+const int n = 15;
+GFp::Element a[n], b[n];
+unsigned char be[n * 32];
+uint64_t overhead;
+
+for (int j = 0; j < n; j++) {
+  gfp.rand(&a[j], my_rand, NULL);
+}
+gfp.toBytes(be, a, n, ecl::BYTES_BE);
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("         toBytes", gfp.toBytes(be, a[0], ecl::BYTES_BE), overhead);
+GET_PERF_CLOCKS("    toBytes (15)", gfp.toBytes(be, a, n, ecl::BYTES_BE), overhead);
+GET_PERF_CLOCKS("       fromBytes", gfp.fromBytes(&b[0], be, ecl::BYTES_BE), overhead);
+GET_PERF_CLOCKS("  fromBytes (15)", gfp.fromBytes(b, be, n, ecl::BYTES_BE), overhead);
+GET_PERF_CLOCKS("      fromString", gfp.fromString(&b[0], a[2].toString()), overhead);
+}
+
+/* p = 3 mod 4 and p = 5 mod 8 */
+static const char *sqrt_primes[2] = {
+  "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af",
+  "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed" };
+
+/** Tests square roots and quadratic residuosity for p = 3 mod 4 and
+ * p = 5 mod 8.
+ */
+TEST(GFpSqrt, FixedExponent){
+GFp::Element a, b, c, s, n;
+
+for (int k = 0; k < 2; k++) {
+  GFp gfp(sqrt_primes[k]);
+
+  /** <ul><li> n is a non residue : legendre(n) == -1 and sqrt(n) fails */
+  gfp.set(&n, 2);
+  gfp.one(&c);
+  while (gfp.legendre(n) != -1) {
+    gfp.add(&n, n, c);
+  }
+  gfp.copy(&b, n);
+  ASSERT_EQ(ecl::ERR_NOT_SQUARE, gfp.sqrt(&b, n));
+  ASSERT_EQ(0, gfp.cmp(b, n));
+  /** <li> legendre(0) == 0 */
+  gfp.zero(&a);
+  ASSERT_EQ(0, gfp.legendre(a));
+
+  for (int i = 0; i < NBTESTS; i++) {
+    do {
+      gfp.rand(&a, my_rand, NULL);
+    } while (gfp.isZero(a));
+    gfp.sqr(&s, a);
+    /** <li> s = a^2 : legendre(s) == 1, sqrt(s)^2 == s */
+    ASSERT_EQ(1, gfp.legendre(s));
+    ASSERT_EQ(ecl::ERR_OK, gfp.sqrt(&b, s));
+    gfp.sqr(&c, b);
+    ASSERT_EQ(0, gfp.cmp(c, s));
+    /** <li> a.n is a non residue */
+    gfp.mul(&c, a, n);
+    ASSERT_EQ(gfp.legendre(a) == 1 ? -1 : 1, gfp.legendre(c));
+    /** <li> sqrt_ratio(s.a, a)^2 == s */
+    gfp.mul(&c, s, a);
+    ASSERT_EQ(ecl::ERR_OK, gfp.sqrt_ratio(&b, c, a));
+    gfp.sqr(&c, b);
+    ASSERT_EQ(0, gfp.cmp(c, s));
+    /** <li> sqrt_ratio(n.s, 1) fails */
+    gfp.mul(&c, s, n);
+    gfp.one(&b);
+    ASSERT_EQ(ecl::ERR_NOT_SQUARE, gfp.sqrt_ratio(&b, c, b));
+    /** <li> inv_sqrt(s)^2 . s == 1 */
+    ASSERT_EQ(ecl::ERR_OK, gfp.inv_sqrt(&b, s));
+    gfp.sqr(&c, b);
+    gfp.mul(&c, c, s);
+    ASSERT_TRUE(gfp.isOne(c));
+  }
+  /**</ul>*/
+  gfp.zero(&a);
+  ASSERT_EQ(ecl::ERR_INVALID_VALUE, gfp.inv_sqrt(&b, a));
+}
+}
+
+TEST(GFpSqrt, Performance){
+GFp::Element a, b, s;
+uint64_t overhead;
+
+for (int k = 0; k < 2; k++) {
+  GFp gfp(sqrt_primes[k]);
+
+  gfp.rand(&a, my_rand, NULL);
+  gfp.sqr(&s, a);
+  GET_OVERHEAD(overhead);
+  GET_PERF_CLOCKS("      legendre", gfp.legendre(s), overhead);
+  GET_PERF_CLOCKS("   square root", gfp.sqrt(&b, s), overhead);
+}
+}
+
+/** Tests the legendre symbol against Euler's criterion a^((p-1)/2), on random
+ * values and values close to 0, p/2 and p.
+ */
+TEST(GFpLegendre, Jacobi){
+const char *primes[3] = {
+  "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af",
+  "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed",
+  "ffffffff00000001000000000000000000000000ffffffffffffffffffffffff" };
+GFp::Element a, e, c, d, h;
+int l;
+
+for (int k = 0; k < 3; k++) {
+  GFp gfp(primes[k]);
+
+  gfp.get_characteristic(&e);
+  gfp.r_shift(&e, e, 1);  // (p-1)/2
+  gfp.r_shift(&h, e, 1);  // ~p/4, p/2 once doubled in Montgomery form
+
+  for (int i = 0; i < 20 * NBTESTS; i++) {
+    switch (i % 4) {
+      case 0:
+        gfp.rand(&a, my_rand, NULL);
+        break;
+      case 1:
+        gfp.set(&a, i / 4 + 1);
+        break;
+      case 2:
+        gfp.set(&a, -(i / 4 + 1));
+        break;
+      default:
+        gfp.set(&d, i / 4);
+        gfp.add(&a, h, d);
+        break;
+    }
+    gfp.exp(&c, a, e);
+    l = gfp.legendre(a);
+    /** <ul><li> legendre(a) == a^((p-1)/2) */
+    if (gfp.isOne(c)) {
+      ASSERT_EQ(1, l);
+    } else {
+      ASSERT_EQ(-1, l);
+    }
+    /** <li> legendre(a^2) == 1 */
+    gfp.sqr(&c, a);
+    ASSERT_EQ(1, gfp.legendre(c));
+    /**</ul>*/
+  }
+  gfp.zero(&a);
+  ASSERT_EQ(0, gfp.legendre(a));
+  gfp.one(&a);
+  ASSERT_EQ(1, gfp.legendre(a));
+}
+}
+
+TEST(GFpLegendre, Performance){
+GFp gfp("b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af");
+GFp::Element a;
+uint64_t overhead;
+
+gfp.rand(&a, my_rand, NULL);
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("      legendre", gfp.legendre(a), overhead);
+}
+
+/** Tests isCNR against the exponent it used before the fixed schedules,
+ * (p - 1) divided by 3 in the field, on the shipped BN primes.
+ */
+TEST(GFpCubic, IsCNR){
+const char *primes[3] = {
+  "2370fb049d410fbe4e761a9886e502417d023f40180000017e80600000000001",
+  "2523648240000001ba344d80000000086121000000000013a700000000000013",
+  "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af" };
+GFp::Element p, pm1, e, three, a, c;
+
+for (int k = 0; k < 3; k++) {
+  GFp gfp(primes[k]);
+  gfp.get_characteristic(&p);
+
+  /** <ul><li> p = 1 mod 3, so that -1/3 in the field is the integer
+   * (p - 1)/3 */
+  gfp.sub(&e, p, 1);
+  gfp.set(&three, 3);
+  gfp.div(&e, e, three);
+  GFp::Element::add(&c, e, e);
+  GFp::Element::add(&c, c, e);
+  GFp::Element::sub(&pm1, p, 1);
+  ASSERT_EQ(0, gfp.cmp(c, pm1));
+
+  for (int i = 0; i < NBTESTS; i++) {
+    /** <li> small candidates, as tried for xsi by Fp2, and random ones */
+    if (i < 16) {
+      gfp.set(&a, i + 1);
+    } else {
+      gfp.rand(&a, my_rand, NULL);
+    }
+    gfp.exp(&c, a, e);
+    ASSERT_EQ(!gfp.isOne(c), gfp.isCNR(a));
+    /** <li> cubes are not CNR */
+    gfp.sqr(&c, a);
+    gfp.mul(&c, c, a);
+    ASSERT_FALSE(gfp.isCNR(c));
+  }
+  /**</ul>*/
+}
+}
 /**@}*/
 
+/** @ingroup Field
+ @defgroup StaticField Test suite for compile time prime fields.
+ Every operation is checked against the runtime GFp with the same
+ characteristic.
+ @addtogroup StaticField
+ @{
+ */
+template<class Field>
+class StaticFieldTest : public testing::Test {
+ protected:
+  StaticFieldTest() {
+    typename Field::Element p;
+    sfield.get_characteristic(&p);
+    field = new GFp(p);
+  }
+
+  virtual ~StaticFieldTest() {
+    delete field;
+    field = NULL;
+  }
+
+ public:
+  Field sfield;
+  GFp *field;
+  GFp::Element a, b, res1, res2;
+};
+
+TYPED_TEST_CASE_P(StaticFieldTest);
+
+TYPED_TEST_P(StaticFieldTest, Constants){
+GFp::Element p;
+/** <ul><li> same characteristic, same 1, same set */
+this->field->get_characteristic(&p);
+ASSERT_EQ(0, memcmp(p.val, TypeParam::k_.p, sizeof(p.val)));
+this->sfield.one(&this->res1);
+this->field->one(&this->res2);
+ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+ASSERT_TRUE(this->sfield.isOne(this->res2));
+this->sfield.set(&this->res1, -12345);
+this->field->set(&this->res2, -12345);
+ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+/**</ul>*/
+}
+
+TYPED_TEST_P(StaticFieldTest, Operations){
+for (int i = 0; i < NBTESTS; i++) {
+  this->field->rand(&this->a, my_rand, NULL);
+  this->sfield.rand(&this->b, my_rand, NULL);
+  /** <ul><li> add, sub, opp, mul, sqr, inv match GFp */
+  this->sfield.add(&this->res1, this->a, this->b);
+  this->field->add(&this->res2, this->a, this->b);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  this->sfield.sub(&this->res1, this->a, this->b);
+  this->field->sub(&this->res2, this->a, this->b);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  this->sfield.opp(&this->res1, this->a);
+  this->field->opp(&this->res2, this->a);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  this->sfield.mul(&this->res1, this->a, this->b);
+  this->field->mul(&this->res2, this->a, this->b);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  this->sfield.sqr(&this->res1, this->a);
+  this->field->sqr(&this->res2, this->a);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  this->sfield.inv(&this->res1, this->a);
+  this->field->inv(&this->res2, this->a);
+  ASSERT_EQ(0, this->field->cmp(this->res1, this->res2));
+  /**</ul>*/
+}
+/** <ul><li> opp(0) == 0, 0 - 1 == -1 */
+this->sfield.zero(&this->a);
+this->sfield.opp(&this->res1, this->a);
+ASSERT_TRUE(this->sfield.isZero(this->res1));
+this->sfield.one(&this->b);
+this->sfield.sub(&this->res1, this->a, this->b);
+this->sfield.set(&this->res2, -1);
+ASSERT_EQ(0, this->sfield.cmp(this->res1, this->res2));
+/**</ul>*/
+}
+
+TYPED_TEST_P(StaticFieldTest, Performance){
+uint64_t overhead;
+
+this->field->rand(&this->a, my_rand, NULL);
+this->field->rand(&this->b, my_rand, NULL);
+this->res1.copy(this->a);
+
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("      addition", this->sfield.add(&this->res1, this->res1, this->b), overhead);
+GET_PERF_CLOCKS("multiplication", this->sfield.mul(&this->res1, this->res1, this->b), overhead);
+GET_PERF_CLOCKS("        square", this->sfield.sqr(&this->res1, this->res1), overhead);
+GET_PERF_CLOCKS("   GFp  mult. ", this->field->mul(&this->res1, this->res1, this->b), overhead);
+}
+
+REGISTER_TYPED_TEST_CASE_P(StaticFieldTest, Constants, Operations,
+                           Performance);
+
+INSTANTIATE_TYPED_TEST_CASE_P(Beuchat254, StaticFieldTest,
+                              StaticGFp<Beuchat254Prime>);
+INSTANTIATE_TYPED_TEST_CASE_P(Aranha254, StaticFieldTest,
+                              StaticGFp<Aranha254Prime>);
+INSTANTIATE_TYPED_TEST_CASE_P(Naering256, StaticFieldTest,
+                              StaticGFp<Naering256Prime>);
+INSTANTIATE_TYPED_TEST_CASE_P(P256, StaticFieldTest, StaticGFp<P256Prime>);
+/**@}*/
+
+/** @ingroup Field
+ @defgroup GFpP256 Test of the P-256 specific reduction.
+ GFp detects the NIST P-256 prime and uses a dedicated Montgomery reduction.
+ Results are checked against the generic reduction of StaticGFp<P256Prime>.
+ @{
+ */
+TEST(GFpP256, Reduction){
+GFp gfp("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff");
+StaticGFp<P256Prime> sfield;
+GFp::Element a, b, c, d, pm1;
+GFp::Double t;
+
+gfp.get_characteristic(&pm1);
+GFp::Element::sub(&pm1, pm1, 1);
+
+for (int i = 0; i < NBTESTS; i++) {
+  switch (i % 4) {
+    case 0:
+      a.copy(pm1);
+      b.copy(pm1);
+      break;
+    case 1:
+      a.copy(pm1);
+      gfp.rand(&b, my_rand, NULL);
+      break;
+    default:
+      gfp.rand(&a, my_rand, NULL);
+      gfp.rand(&b, my_rand, NULL);
+      break;
+  }
+  sfield.mul(&d, a, b);
+  /** <ul><li> mul */
+  gfp.mul(&c, a, b);
+  ASSERT_EQ(0, gfp.cmp(c, d));
+  /** <li> double size product then reduce */
+  gfp.mul(&t, a, b);
+  gfp.reduce(&c, t);
+  ASSERT_EQ(0, gfp.cmp(c, d));
+  /** <li> sqr */
+  sfield.sqr(&d, a);
+  gfp.sqr(&c, a);
+  ASSERT_EQ(0, gfp.cmp(c, d));
+  /**</ul>*/
+}
+}
+
+TEST(GFpP256, Performance){
+GFp gfp("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff");
+GFp::Element a, b;
+GFp::Double t;
+uint64_t overhead;
+
+gfp.rand(&a, my_rand, NULL);
+gfp.rand(&b, my_rand, NULL);
+gfp.mul(&t, a, b);
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("multiplication", gfp.mul(&a, a, b), overhead);
+GET_PERF_CLOCKS("        square", gfp.sqr(&a, a), overhead);
+GET_PERF_CLOCKS("     reduction", gfp.reduce(&a, t), overhead);
+}
+/**@}*/
+
+/** @ingroup Field
+ @defgroup LimbsField Test suite for prime fields of any number of limbs.
+ GFpN is checked with field identities for 4, 6 and 8 limbs, and so are the
+ extension fields built on a prime of another size than GFp.
+ @addtogroup LimbsField
+ @{
+ */
+template<int nb_limbs>
+struct LimbsPrime;
+
+#ifdef DIGIT_64
+template<>
+struct LimbsPrime<4> {
+  static const char *str() {
+    return "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af";
+  }
+};
+/** BLS12-381 */
+template<>
+struct LimbsPrime<6> {
+  static const char *str() {
+    return "1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f624"
+        "1eabfffeb153ffffb9feffffffffaaab";
+  }
+};
+/** 2^512 - 569 */
+template<>
+struct LimbsPrime<8> {
+  static const char *str() {
+    return "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7";
+  }
+};
+#else
+/** 2^127 - 1 */
+template<>
+struct LimbsPrime<4> {
+  static const char *str() {
+    return "7fffffffffffffffffffffffffffffff";
+  }
+};
+/** NIST P-192 */
+template<>
+struct LimbsPrime<6> {
+  static const char *str() {
+    return "fffffffffffffffffffffffffffffffeffffffffffffffff";
+  }
+};
+template<>
+struct LimbsPrime<8> {
+  static const char *str() {
+    return "b64000000000ff2f2200000085fd5480b0001f44b6b88bf142bc818f95e3e6af";
+  }
+};
+#endif
+
+template<class Field>
+class LimbsFieldTest : public testing::Test {
+ protected:
+  LimbsFieldTest()
+      : field(LimbsPrime<Field::Element::nb_limbs_>::str()) {
+  }
+
+ public:
+  Field field;
+  typename Field::Element a, b, c, res1, res2;
+  typename Field::Double t;
+};
+
+TYPED_TEST_CASE_P(LimbsFieldTest);
+
+TYPED_TEST_P(LimbsFieldTest, Operations){
+typename TypeParam::Element e, e2, in[8], out[8];
+unsigned char buf[sizeof(e.val)];
+
+this->field.get_characteristic(&e);
+TypeParam::Element::sub(&e, e, 1);  // p - 1
+TypeParam::Element::r_shift(&e2, e, 1);  // (p - 1) / 2
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->field.rand(&this->a, my_rand, NULL);
+  this->field.rand(&this->b, my_rand, NULL);
+  this->field.rand(&this->c, my_rand, NULL);
+  /** <ul><li> (a + b).c == a.c + b.c */
+  this->field.add(&this->res1, this->a, this->b);
+  this->field.mul(&this->res1, this->res1, this->c);
+  this->field.mul(&this->res2, this->a, this->c);
+  this->field.mul(&this->a, this->b, this->c);
+  this->field.add(&this->res2, this->res2, this->a);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  /** <li> (a - b) + b == a */
+  this->field.sub(&this->res1, this->a, this->b);
+  this->field.add(&this->res1, this->res1, this->b);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->a));
+  /** <li> sqr(a) == a.a, in both reduced and double size forms */
+  this->field.sqr(&this->res1, this->a);
+  this->field.mul(&this->res2, this->a, this->a);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  this->field.sqr(&this->t, this->a);
+  this->field.reduce(&this->res2, this->t);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  this->field.mul(&this->t, this->a, this->b);
+  this->field.reduce(&this->res1, this->t);
+  this->field.mul(&this->res2, this->a, this->b);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  /** <li> a^(p-1) == 1 */
+  this->field.exp(&this->res1, this->a, e);
+  ASSERT_TRUE(this->field.isOne(this->res1));
+  /** <li> a / b . b == a */
+  this->field.div(&this->res1, this->a, this->b);
+  this->field.mul(&this->res1, this->res1, this->b);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->a));
+  /** <li> legendre(a) == a^((p-1)/2) */
+  this->field.exp(&this->res1, this->a, e2);
+  ASSERT_EQ(this->field.isOne(this->res1) ? 1 : -1,
+            this->field.legendre(this->a));
+  /** <li> sqrt(a^2)^2 == a^2 */
+  this->field.sqr(&this->res1, this->a);
+  ASSERT_EQ(ecl::ERR_OK, this->field.sqrt(&this->res2, this->res1));
+  this->field.sqr(&this->res2, this->res2);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  /** <li> fromBytes(toBytes(a)) == a */
+  this->field.toBytes(buf, this->a, ecl::BYTES_BE);
+  ASSERT_EQ(ecl::ERR_OK, this->field.fromBytes(&this->res1, buf, ecl::BYTES_BE));
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->a));
+  /**</ul>*/
+}
+/** <ul><li> a[i].inv_batch(a)[i] == 1 */
+for (int j = 0; j < 8; j++) {
+  this->field.rand(&in[j], my_rand, NULL);
+}
+this->field.inv_batch(out, in, 8);
+for (int j = 0; j < 8; j++) {
+  this->field.mul(&this->res1, in[j], out[j]);
+  ASSERT_TRUE(this->field.isOne(this->res1));
+}
+/** <li> (p-1)^2 == 1, largest operands */
+this->field.mul(&this->res1, e, e);
+this->field.sqr(&this->res2, e);
+ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+this->field.set(&this->a, -1);
+this->field.sqr(&this->res1, this->a);
+ASSERT_TRUE(this->field.isOne(this->res1));
+/** <li> -1 + 1 == 0 */
+this->field.one(&this->res2);
+this->field.add(&this->res1, this->a, this->res2);
+ASSERT_TRUE(this->field.isZero(this->res1));
+/**</ul>*/
+}
+
+TYPED_TEST_P(LimbsFieldTest, Performance){
+uint64_t overhead;
+
+this->field.rand(&this->a, my_rand, NULL);
+this->field.rand(&this->b, my_rand, NULL);
+this->res1.copy(this->a);
+
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("      addition", this->field.add(&this->res1, this->res1, this->b), overhead);
+GET_PERF_CLOCKS("multiplication", this->field.mul(&this->res1, this->res1, this->b), overhead);
+GET_PERF_CLOCKS("        square", this->field.sqr(&this->res1, this->res1), overhead);
+GET_PERF_CLOCKS("     inversion", this->field.inv(&this->res1, this->res1), overhead);
+}
+
+REGISTER_TYPED_TEST_CASE_P(LimbsFieldTest, Operations, Performance);
+
+INSTANTIATE_TYPED_TEST_CASE_P(Limbs4, LimbsFieldTest, GFpN<4>);
+INSTANTIATE_TYPED_TEST_CASE_P(Limbs6, LimbsFieldTest, GFpN<6>);
+INSTANTIATE_TYPED_TEST_CASE_P(Limbs8, LimbsFieldTest, GFpN<8>);
+
+/** GFp and its extensions are the NB_LIMBS instances */
+static_assert(std::is_same<GFp, GFpN<NB_LIMBS> >::value, "GFp");
+static_assert(std::is_same<Fp12, Fp12N<NB_LIMBS> >::value, "Fp12");
+
+#ifdef DIGIT_64
+static const int kTowerLimbs = 6;  // BLS12-381
+#else
+static const int kTowerLimbs = 8;  // BN254
+#endif
+
+/** Extension fields over the prime of LimbsPrime<kTowerLimbs>, p = 1 mod 6 */
+template<class Field>
+class LimbsTowerTest : public testing::Test {
+ protected:
+  LimbsTowerTest()
+      : field(LimbsPrime<kTowerLimbs>::str()) {
+  }
+
+ public:
+  Field field;
+  typename Field::GFp::Element p;
+  typename Field::Element a, b, c, res1, res2;
+};
+
+TYPED_TEST_CASE_P(LimbsTowerTest);
+
+TYPED_TEST_P(LimbsTowerTest, Operations){
+typename TypeParam::Element in[8], out[8];
+
+this->field.get_characteristic(&this->p);
+
+for (int i = 0; i < NBTESTS; i++) {
+  this->field.rand(&this->a, my_rand, NULL);
+  this->field.rand(&this->b, my_rand, NULL);
+  this->field.rand(&this->c, my_rand, NULL);
+  /** <ul><li> (a + b).c == a.c + b.c */
+  this->field.add(&this->res1, this->a, this->b);
+  this->field.mul(&this->res1, this->res1, this->c);
+  this->field.mul(&this->res2, this->a, this->c);
+  this->field.mul(&this->a, this->b, this->c);
+  this->field.add(&this->res2, this->res2, this->a);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  /** <li> sqr(a) == a.a */
+  this->field.sqr(&this->res1, this->a);
+  this->field.mul(&this->res2, this->a, this->a);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  /** <li> a / b . b == a */
+  this->field.div(&this->res1, this->a, this->b);
+  this->field.mul(&this->res1, this->res1, this->b);
+  ASSERT_EQ(0, this->field.cmp(this->res1, this->a));
+  /** <li> frobenius(a, 1) == a^p, Fp6 has no Frobenius */
+  if (this->field.frobenius(&this->res1, this->a, 1) == ecl::ERR_OK) {
+    this->field.exp(&this->res2, this->a, this->p);
+    ASSERT_EQ(0, this->field.cmp(this->res1, this->res2));
+  }
+  /**</ul>*/
+}
+/** <ul><li> a[i].inv_batch(a)[i] == 1 */
+for (int j = 0; j < 8; j++) {
+  this->field.rand(&in[j], my_rand, NULL);
+}
+this->field.inv_batch(out, in, 8);
+for (int j = 0; j < 8; j++) {
+  this->field.mul(&this->res1, in[j], out[j]);
+  ASSERT_TRUE(this->field.isOne(this->res1));
+}
+/**</ul>*/
+}
+
+TYPED_TEST_P(LimbsTowerTest, Performance){
+uint64_t overhead;
+
+this->field.rand(&this->a, my_rand, NULL);
+this->field.rand(&this->b, my_rand, NULL);
+this->field.copy(&this->res1, this->a);
+
+GET_OVERHEAD(overhead);
+GET_PERF_CLOCKS("multiplication", this->field.mul(&this->res1, this->res1, this->b), overhead);
+GET_PERF_CLOCKS("        square", this->field.sqr(&this->res1, this->res1), overhead);
+GET_PERF_CLOCKS("     inversion", this->field.inv(&this->res1, this->res1), overhead);
+}
+
+REGISTER_TYPED_TEST_CASE_P(LimbsTowerTest, Operations, Performance);
+
+INSTANTIATE_TYPED_TEST_CASE_P(Fp2, LimbsTowerTest, Fp2N<kTowerLimbs>);
+INSTANTIATE_TYPED_TEST_CASE_P(Fp6, LimbsTowerTest, Fp6N<kTowerLimbs>);
+INSTANTIATE_TYPED_TEST_CASE_P(Fp12, LimbsTowerTest, Fp12N<kTowerLimbs>);
+/**@}*/